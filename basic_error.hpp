@@ -4,17 +4,17 @@
 #include <stdexcept>
 #include <string>
 
-/* It's just an error class that inherits from std::exception, it supports strings as input
-(idk how it is on other compilers but on MSVC it takes in only const char pointer basically) */ 
+/* It's just an error class that inherits from std::runtime_error, it supports strings as input
+(std::exception only takes a const char pointer on MSVC and nothing at all on GCC and Clang) */
 
 namespace dt0
 {
-	class basic_error : public std::exception
+	class basic_error : public std::runtime_error
 	{
 	public:
-		using base = std::exception;
+		using base = std::runtime_error;
 	
-		basic_error() noexcept : base() {}
+		basic_error() noexcept : base("") {}
 	
 		explicit basic_error(char const* const message) noexcept : base(message) {}
 	
@@ -0,0 +1,329 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+#include "core_macros.hpp"
+#include "date_time.hpp"
+#include "date_time_format.hpp"
+#include "date_column.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+/* Micro benchmarks for the date_time.hpp types, run it after changes to catch regressions and to see what fits on a request path.
+Build it as the README says, g++ -O2 -std=c++17 -I. benchmark.cpp -o benchmark plus -mavx2 for the column kernels.
+
+Every row is the best of several runs and reports nanoseconds per operation, heap allocations per operation (counted through
+the replaced global operator new) and throughput, in bytes for formatting and parsing and in operations everywhere else.
+Inputs cycle through a table of random instants between 1970 and 2100 so nothing folds into a constant. */
+
+namespace
+{
+	std::size_t allocations = 0;
+
+	/* Keeps value alive and opaque to the optimizer */
+	template <class T>
+	inline void keep(const T& value)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		static const void* volatile sink;
+
+		sink = &value;
+		_ReadWriteBarrier();
+#else
+		asm volatile("" : : "r"(&value) : "memory");
+#endif
+	}
+
+	constexpr std::size_t input_size = 4096;
+	constexpr std::size_t column_size = 1 << 16;
+	constexpr int runs = 5;
+
+	/* Prints one row, bytes is the text size of one operation (0 for none) */
+	void report(const char* name, double best, double per_op, std::size_t bytes)
+	{
+		if (bytes != 0)
+			std::printf("%-44s %10.2f ns/op %8.2f allocs/op %10.1f MB/s\n", name, best, per_op, static_cast<double>(bytes) * 1e3 / best);
+		else
+			std::printf("%-44s %10.2f ns/op %8.2f allocs/op %10.1f Mops/s\n", name, best, per_op, 1e3 / best);
+	}
+
+	/* Calls f runs times and prints the best run, each call does values operations */
+	template <class F>
+	void best_of_runs(const char* name, std::size_t values, std::size_t bytes, F&& f)
+	{
+		double best = 1e300;
+		std::size_t allocated = 0;
+
+		for (int run = 0; run < runs; ++run)
+		{
+			const std::size_t before = allocations;
+			const auto start = std::chrono::steady_clock::now();
+
+			f();
+
+			const double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+			best = std::min(best, elapsed / static_cast<double>(values));
+			allocated = allocations - before;
+		}
+
+		report(name, best, static_cast<double>(allocated) / static_cast<double>(values), bytes);
+	}
+
+	/* Runs f(i) for i in [0, iterations) runs times and prints the best run */
+	template <class F>
+	void measure(const char* name, std::size_t iterations, std::size_t bytes, F&& f)
+	{
+		for (std::size_t i = 0; i < iterations / 10 + 1; ++i)
+			f(i);
+
+		best_of_runs(name, iterations, bytes, [&]()
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+				f(i);
+		});
+	}
+
+	/* Same for kernels that handle count values per call, reported per value */
+	template <class F>
+	void measure_bulk(const char* name, std::size_t count, std::size_t bytes, F&& f)
+	{
+		f();
+
+		best_of_runs(name, count, bytes, f);
+	}
+
+	void section(const char* title)
+	{
+		std::printf("\n%s\n", title);
+	}
+
+	/* Every replaced operator new and delete goes through these two, kept out of line so that after inlining the compiler never
+	sees a pointer from operator new handed straight to free (GCC's -Wmismatched-new-delete) */
+	___noinline___ void* counted_allocate(std::size_t size) noexcept
+	{
+		++allocations;
+
+		return std::malloc(size != 0 ? size : 1);
+	}
+
+	___noinline___ void counted_release(void* p) noexcept
+	{
+		std::free(p);
+	}
+}
+
+void* operator new(std::size_t size)
+{
+	if (void* p = counted_allocate(size))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	if (void* p = counted_allocate(size))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return counted_allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	counted_release(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	counted_release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	counted_release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	counted_release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	counted_release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	counted_release(p);
+}
+
+int main()
+{
+	using namespace dt0;
+
+	const std::size_t n = 1000000;
+
+	std::mt19937_64 _random(2026);
+
+	std::vector<std::int64_t> _ticks(column_size);
+	std::vector<date_time> _date_times;
+	std::vector<timestamp> _timestamps;
+	std::vector<std::string> _texts;
+
+	for (std::int64_t& t : _ticks)
+		t = static_cast<std::int64_t>(_random() % static_cast<std::uint64_t>(47846 * ticks_per_day));
+
+	for (std::size_t i = 0; i < input_size; ++i)
+	{
+		_date_times.push_back(date_time::from_ticks(_ticks[i]));
+		_timestamps.push_back(timestamp(_ticks[i]));
+
+		char _buffer[timestamp::max_chars];
+
+		_texts.emplace_back(_buffer, _timestamps.back().to_chars(_buffer, _buffer + timestamp::max_chars, 3, true).ptr);
+	}
+
+	static const char* const day_names[] = { "Monday", "tue", "WEDNESDAY", "thu", "Fri", "saturday", "SUN" };
+	static const char* const month_names[] = { "January", "feb", "MARCH", "apr", "May", "june", "Jul", "august", "SEP", "oct", "November", "dec" };
+
+	section("construction");
+
+	measure("time(h, m, s, ms)", n, 0, [&](std::size_t i) { keep(dt0::time(static_cast<unsigned short>(i % 24), static_cast<unsigned short>(i % 60), 30, 500)); });
+	measure("day(week_index, month_index)", n, 0, [&](std::size_t i) { keep(day(static_cast<unsigned short>(i % 7 + 1), static_cast<unsigned short>(i % 28 + 1))); });
+	measure("day(name, week_index, month_index)", n, 0, [&](std::size_t i) { keep(day(day_names[i % 7], static_cast<unsigned short>(i % 7 + 1), 1)); });
+	measure("month(index)", n, 0, [&](std::size_t i) { keep(month(static_cast<unsigned short>(i % 12 + 1))); });
+	measure("month(name, index, days)", n, 0, [&](std::size_t i) { const month M(static_cast<unsigned short>(i % 12 + 1)); keep(month(month_names[i % 12], M.index(), M.days())); });
+	measure("year(value, bce)", n, 0, [&](std::size_t i) { keep(year(1970 + i % 130, false)); });
+	measure("date(year, month, day)", n, 0, [&](std::size_t i) { keep(date(year(2026, false), month(10), day(static_cast<unsigned short>((i + 3) % 7 + 1), static_cast<unsigned short>(i % 7 + 12)))); });
+	measure("date::from_days", n, 0, [&](std::size_t i) { keep(date::from_days(_ticks[i % input_size] / ticks_per_day)); });
+	measure("date_time(date, time)", n, 0, [&](std::size_t i) { keep(date_time(_date_times[i % input_size].get_date(), dt0::time(12, 0, 0, 0))); });
+	measure("date_time::from_ticks", n, 0, [&](std::size_t i) { keep(date_time::from_ticks(_ticks[i % input_size])); });
+	measure("time::from_ticks", n, 0, [&](std::size_t i) { keep(dt0::time::from_ticks(_ticks[i % input_size])); });
+	measure("timestamp(date_time)", n, 0, [&](std::size_t i) { keep(timestamp(_date_times[i % input_size])); });
+	measure("timestamp::to_date_time", n, 0, [&](std::size_t i) { keep(_timestamps[i % input_size].to_date_time()); });
+	measure("duration<>(std::chrono::milliseconds)", n, 0, [&](std::size_t i) { keep(duration<>(std::chrono::milliseconds(static_cast<std::int64_t>(i)))); });
+
+	section("copy and move");
+
+	measure("date_time copy", n, 0, [&](std::size_t i) { date_time copy(_date_times[i % input_size]); keep(copy); });
+	measure("date_time move", n, 0, [&](std::size_t i) { date_time source(_date_times[i % input_size]); date_time moved(std::move(source)); keep(moved); });
+	measure("timestamp copy", n, 0, [&](std::size_t i) { timestamp copy(_timestamps[i % input_size]); keep(copy); });
+
+	section("clocks");
+
+	measure("utc_ticks(realtime)", n, 0, [&](std::size_t) { keep(utc_ticks(clock_source::realtime)); });
+	measure("utc_ticks(realtime_coarse)", n, 0, [&](std::size_t) { keep(utc_ticks(clock_source::realtime_coarse)); });
+	measure("utc_ticks(monotonic)", n, 0, [&](std::size_t) { keep(utc_ticks(clock_source::monotonic)); });
+	measure("local_ticks(realtime)", n, 0, [&](std::size_t) { keep(local_ticks(clock_source::realtime)); });
+	measure("timestamp::utc_now(realtime)", n, 0, [&](std::size_t) { keep(timestamp::utc_now(clock_source::realtime)); });
+	measure("date_time::now(realtime)", n, 0, [&](std::size_t) { keep(date_time::now(clock_source::realtime)); });
+	measure("date_time::now(realtime_coarse)", n, 0, [&](std::size_t) { keep(date_time::now(clock_source::realtime_coarse)); });
+	measure("date_time::now(monotonic)", n, 0, [&](std::size_t) { keep(date_time::now(clock_source::monotonic)); });
+	measure("date::now(realtime)", n, 0, [&](std::size_t) { keep(date::now(clock_source::realtime)); });
+	measure("time::now(realtime)", n, 0, [&](std::size_t) { keep(dt0::time::now(clock_source::realtime)); });
+
+	section("arithmetic");
+
+	measure("date_time::add_months", n, 0, [&](std::size_t i) { keep(_date_times[i % input_size].add_months(static_cast<std::int64_t>(i % 25) - 12)); });
+	measure("timestamp::add_months", n, 0, [&](std::size_t i) { keep(_timestamps[i % input_size].add_months(static_cast<std::int64_t>(i % 25) - 12)); });
+	measure("timestamp::floor(time_unit::week)", n, 0, [&](std::size_t i) { keep(_timestamps[i % input_size].floor(time_unit::week)); });
+	measure("timestamp::bucket(time_unit::month)", n, 0, [&](std::size_t i) { keep(_timestamps[i % input_size].bucket(time_unit::month)); });
+	measure("date::days_until", n, 0, [&](std::size_t i) { keep(_date_times[i % input_size].get_date().days_until(_date_times[(i + 1) % input_size].get_date())); });
+
+	section("formatting");
+
+	char _buffer[256];
+
+	measure("time::as_string", n, 12, [&](std::size_t i) { keep(_date_times[i % input_size].get_time().as_string()); });
+	measure("time::to_chars", n, 12, [&](std::size_t i) { keep(_date_times[i % input_size].get_time().to_chars(_buffer, _buffer + sizeof(_buffer))); });
+	measure("date::to_chars", n, 10, [&](std::size_t i) { keep(_date_times[i % input_size].get_date().to_chars(_buffer, _buffer + sizeof(_buffer))); });
+	measure("date_time::to_chars", n, 23, [&](std::size_t i) { keep(_date_times[i % input_size].to_chars(_buffer, _buffer + sizeof(_buffer))); });
+	measure("timestamp::to_chars(3 digits, utc)", n, 24, [&](std::size_t i) { keep(_timestamps[i % input_size].to_chars(_buffer, _buffer + sizeof(_buffer), 3, true)); });
+	measure("timestamp::to_chars(7 digits, utc)", n, 28, [&](std::size_t i) { keep(_timestamps[i % input_size].to_chars(_buffer, _buffer + sizeof(_buffer), 7, true)); });
+	measure("duration<>::as_string", n, 16, [&](std::size_t i) { keep(duration<>(_ticks[i % input_size] % ticks_per_day).as_string()); });
+
+	const date_time_format _format("%d/%b/%Y:%H:%M:%S %z");
+
+	measure("date_time_format::to_chars (CLF)", n, 26, [&](std::size_t i) { keep(_format.to_chars(_buffer, _buffer + sizeof(_buffer), _timestamps[i % input_size])); });
+
+	section("parsing");
+
+	measure("from_chars(timestamp) RFC 3339", n, 24, [&](std::size_t i)
+	{
+		const std::string& text = _texts[i % input_size];
+		timestamp value;
+
+		keep(from_chars(text.data(), text.data() + text.size(), value));
+		keep(value);
+	});
+
+	measure("from_chars(date_time) RFC 3339", n, 24, [&](std::size_t i)
+	{
+		const std::string& text = _texts[i % input_size];
+		date_time value;
+
+		keep(from_chars(text.data(), text.data() + text.size(), value));
+		keep(value);
+	});
+
+	std::vector<std::string> _clf;
+
+	for (std::size_t i = 0; i < input_size; ++i)
+		_clf.push_back(_format.as_string(_timestamps[i]));
+
+	measure("date_time_format::from_chars (CLF)", n, 26, [&](std::size_t i)
+	{
+		const std::string& text = _clf[i % input_size];
+		std::int64_t value = 0;
+
+		keep(_format.from_chars(text.data(), text.data() + text.size(), value));
+		keep(value);
+	});
+
+	section("bulk (per value)");
+
+	std::vector<std::int32_t> _years(column_size);
+	std::vector<std::uint8_t> _bytes(column_size);
+	std::vector<std::int64_t> _buckets(column_size);
+	std::vector<std::int64_t> _sorted(column_size);
+	std::vector<char> _text(column_size * (_format.max_size() + 1));
+
+	measure_bulk("extract_years", column_size, 0, [&]() { extract_years(_ticks.data(), column_size, _years.data()); keep(_years[0]); });
+	measure_bulk("extract_months", column_size, 0, [&]() { extract_months(_ticks.data(), column_size, _bytes.data()); keep(_bytes[0]); });
+	measure_bulk("extract_weekdays", column_size, 0, [&]() { extract_weekdays(_ticks.data(), column_size, _bytes.data()); keep(_bytes[0]); });
+	measure_bulk("bucket_ticks(time_unit::month)", column_size, 0, [&]() { bucket_ticks(_ticks.data(), column_size, time_unit::month, _buckets.data()); keep(_buckets[0]); });
+	measure_bulk("date_time::from_ticks over a column", column_size, 0, [&]()
+	{
+		for (std::size_t i = 0; i < column_size; ++i)
+			keep(date_time::from_ticks(_ticks[i]));
+	});
+	measure_bulk("radix_sort(ticks)", column_size, 8, [&]()
+	{
+		std::copy(_ticks.begin(), _ticks.end(), _sorted.begin());
+		radix_sort(_sorted.data(), _sorted.data() + column_size);
+		keep(_sorted[0]);
+	});
+	measure_bulk("date_time_format::format(ticks) (CLF)", column_size, 27, [&]() { keep(_format.format(_ticks.data(), column_size, _text.data())); });
+
+	return 0;
+}
@@ -0,0 +1,278 @@
+#ifndef BINARY_FORMAT_HPP
+#define BINARY_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+#include "mapped_file.hpp"
+
+/* A fixed width little endian binary encoding for the date_time.hpp types:
+
+	date		4 bytes, int32 days since 1970-01-01
+	time		4 bytes, uint32 milliseconds since midnight
+	date_time	8 bytes, int64 100 nanosecond ticks since 1970-01-01 00:00:00
+	timestamp	8 bytes, the same as date_time
+
+to_bytes() and from_bytes() write and read a single record and return the position after it.
+binary_view reads an array of records in place, for example straight out of a mapped_file, without copying or parsing anything up front. */
+
+namespace dt0
+{
+	namespace detail
+	{
+		inline void store_le32(unsigned char* out, std::uint32_t value) noexcept
+		{
+			out[0] = static_cast<unsigned char>(value);
+			out[1] = static_cast<unsigned char>(value >> 8);
+			out[2] = static_cast<unsigned char>(value >> 16);
+			out[3] = static_cast<unsigned char>(value >> 24);
+		}
+
+		inline void store_le64(unsigned char* out, std::uint64_t value) noexcept
+		{
+			store_le32(out, static_cast<std::uint32_t>(value));
+			store_le32(out + 4, static_cast<std::uint32_t>(value >> 32));
+		}
+
+		/* Compilers turn the byte assembly into a single load on little endian targets */
+		___nodiscard___ inline std::uint32_t load_le32(const unsigned char* in) noexcept
+		{
+			return static_cast<std::uint32_t>(in[0]) | (static_cast<std::uint32_t>(in[1]) << 8)
+				| (static_cast<std::uint32_t>(in[2]) << 16) | (static_cast<std::uint32_t>(in[3]) << 24);
+		}
+
+		___nodiscard___ inline std::uint64_t load_le64(const unsigned char* in) noexcept
+		{
+			return static_cast<std::uint64_t>(load_le32(in)) | (static_cast<std::uint64_t>(load_le32(in + 4)) << 32);
+		}
+
+		template <class T>
+		struct binary_traits;
+
+		template <>
+		struct binary_traits<date>
+		{
+			static ___constexpr___ std::size_t size = 4;
+		};
+
+		template <>
+		struct binary_traits<time>
+		{
+			static ___constexpr___ std::size_t size = 4;
+		};
+
+		template <>
+		struct binary_traits<date_time>
+		{
+			static ___constexpr___ std::size_t size = 8;
+		};
+
+		template <>
+		struct binary_traits<timestamp>
+		{
+			static ___constexpr___ std::size_t size = 8;
+		};
+	}
+
+	template <class T>
+	inline ___constexpr___ std::size_t binary_size = detail::binary_traits<T>::size;
+
+	/* Dates have to be within about 5.8 million years of 1970 */
+	inline unsigned char* to_bytes(const date& value, unsigned char* out)
+	{
+		const std::int64_t days = value.days_since_epoch();
+
+		if ((days < INT32_MIN) || (days > INT32_MAX))
+			throw basic_error("Date out of binary range!");
+
+		detail::store_le32(out, static_cast<std::uint32_t>(days));
+
+		return out + 4;
+	}
+
+	inline unsigned char* to_bytes(const time& value, unsigned char* out) noexcept
+	{
+		detail::store_le32(out, static_cast<std::uint32_t>(((value.hours() * 60u + value.minutes()) * 60u + value.seconds()) * 1000u + value.milliseconds()));
+
+		return out + 4;
+	}
+
+	inline unsigned char* to_bytes(const date_time& value, unsigned char* out) noexcept
+	{
+		detail::store_le64(out, static_cast<std::uint64_t>(value.ticks()));
+
+		return out + 8;
+	}
+
+	inline unsigned char* to_bytes(timestamp value, unsigned char* out) noexcept
+	{
+		detail::store_le64(out, static_cast<std::uint64_t>(value.ticks()));
+
+		return out + 8;
+	}
+
+	inline const unsigned char* from_bytes(const unsigned char* in, date& value)
+	{
+		value = date::from_days(static_cast<std::int32_t>(detail::load_le32(in)));
+
+		return in + 4;
+	}
+
+	/* Values of a day or more wrap around midnight */
+	inline const unsigned char* from_bytes(const unsigned char* in, time& value)
+	{
+		value = time::from_ticks(static_cast<std::int64_t>(detail::load_le32(in)) * ticks_per_millisecond);
+
+		return in + 4;
+	}
+
+	inline const unsigned char* from_bytes(const unsigned char* in, date_time& value)
+	{
+		value = date_time::from_ticks(static_cast<std::int64_t>(detail::load_le64(in)));
+
+		return in + 8;
+	}
+
+	inline const unsigned char* from_bytes(const unsigned char* in, timestamp& value) noexcept
+	{
+		value = timestamp(static_cast<std::int64_t>(detail::load_le64(in)));
+
+		return in + 8;
+	}
+
+	/* A read only array of records of type T over memory it does not own, each record is decoded when it is read */
+	template <class T>
+	class binary_view
+	{
+	public:
+		using value_type = T;
+		using size_type = std::size_t;
+
+		static ___constexpr___ std::size_t record_size = binary_size<T>;
+
+		class iterator
+		{
+		public:
+			using value_type = T;
+			using difference_type = std::ptrdiff_t;
+			using reference = T;
+			using pointer = void;
+			using iterator_category = std::input_iterator_tag;
+
+			___constexpr___ iterator() noexcept : _position(nullptr) {}
+
+			explicit ___constexpr___ iterator(const unsigned char* position) noexcept : _position(position) {}
+
+			___nodiscard___ T operator* () const
+			{
+				T value;
+
+				from_bytes(_position, value);
+
+				return value;
+			}
+
+			iterator& operator++ () noexcept
+			{
+				_position += record_size;
+
+				return *this;
+			}
+
+			iterator operator++ (int) noexcept
+			{
+				iterator _previous = *this;
+
+				_position += record_size;
+
+				return _previous;
+			}
+
+			___nodiscard___ ___constexpr___ bool operator== (const iterator& other) const noexcept
+			{
+				return _position == other._position;
+			}
+
+			___nodiscard___ ___constexpr___ bool operator!= (const iterator& other) const noexcept
+			{
+				return _position != other._position;
+			}
+
+		private:
+			const unsigned char* _position;
+		};
+
+		___constexpr___ binary_view() noexcept : _data(nullptr), _size(0) {}
+
+		binary_view(const void* data, std::size_t bytes) : _data(static_cast<const unsigned char*>(data)), _size(bytes / record_size)
+		{
+			if ((bytes % record_size) != 0)
+				throw basic_error("Binary data is not a whole number of records!");
+		}
+
+		explicit binary_view(const mapped_file& file) : binary_view(file.data(), file.size()) {}
+
+		___nodiscard___ ___constexpr___ size_type size() const noexcept
+		{
+			return _size;
+		}
+
+		___nodiscard___ ___constexpr___ bool empty() const noexcept
+		{
+			return _size == 0;
+		}
+
+		___nodiscard___ ___constexpr___ const unsigned char* data() const noexcept
+		{
+			return _data;
+		}
+
+		___nodiscard___ T operator[] (size_type index) const
+		{
+			T value;
+
+			from_bytes(_data + index * record_size, value);
+
+			return value;
+		}
+
+		___nodiscard___ iterator begin() const noexcept
+		{
+			return iterator(_data);
+		}
+
+		___nodiscard___ iterator end() const noexcept
+		{
+			return iterator(_data + _size * record_size);
+		}
+
+		/* The tick count of a date_time or timestamp record without building the object */
+		___nodiscard___ std::int64_t ticks(size_type index) const noexcept
+		{
+			static_assert(record_size == 8, "Only date_time and timestamp records hold ticks");
+
+			return static_cast<std::int64_t>(detail::load_le64(_data + index * record_size));
+		}
+
+		/* The records themselves as an array of ticks for the date_column kernels, or nullptr when the host is big endian
+		or the data is not 8 byte aligned (mapped files always are) */
+		___nodiscard___ const std::int64_t* raw_ticks() const noexcept
+		{
+			static_assert(record_size == 8, "Only date_time and timestamp records hold ticks");
+
+			if (___big_endian___ || ((reinterpret_cast<std::uintptr_t>(_data) % alignof(std::int64_t)) != 0))
+				return nullptr;
+
+			return reinterpret_cast<const std::int64_t*>(_data);
+		}
+
+	private:
+		const unsigned char* _data;
+		size_type _size;
+	};
+}
+
+#endif /* BINARY_FORMAT_HPP */
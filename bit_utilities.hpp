@@ -0,0 +1,57 @@
+#ifndef BIT_UTILITIES_HPP
+#define BIT_UTILITIES_HPP
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+#include <cstdint>
+#include "core_macros.hpp"
+
+/* Bit counting helpers for the bitmap and bit stream classes (business_calendar, timing_wheel, timestamp_codec) */
+
+namespace dt0
+{
+	namespace detail
+	{
+		/* Without a popcnt target (-mpopcnt or -mavx on GCC and Clang, /arch:AVX on MSVC) the builtin is a library call, the SWAR sum is faster */
+		___nodiscard___ inline unsigned int popcount64(std::uint64_t value) noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__) && defined(_WIN64) && defined(__AVX__)
+			return static_cast<unsigned int>(__popcnt64(value));
+#elif defined(__POPCNT__)
+			return static_cast<unsigned int>(__builtin_popcountll(value));
+#else
+			value = value - ((value >> 1) & 0x5555555555555555ull);
+			value = (value & 0x3333333333333333ull) + ((value >> 2) & 0x3333333333333333ull);
+			value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+			return static_cast<unsigned int>((value * 0x0101010101010101ull) >> 56);
+#endif
+		}
+
+		/* value must not be 0 */
+		___nodiscard___ inline unsigned int count_trailing_zeros(std::uint64_t value) noexcept
+		{
+#if defined(_MSC_VER) && !defined(__clang__)
+			unsigned long index;
+
+	#ifdef _WIN64
+			_BitScanForward64(&index, value);
+	#else
+			if (!_BitScanForward(&index, static_cast<unsigned long>(value)))
+			{
+				_BitScanForward(&index, static_cast<unsigned long>(value >> 32));
+				index += 32;
+			}
+	#endif
+
+			return static_cast<unsigned int>(index);
+#else
+			return static_cast<unsigned int>(__builtin_ctzll(value));
+#endif
+		}
+	}
+}
+
+#endif /* BIT_UTILITIES_HPP */
@@ -0,0 +1,316 @@
+#ifndef BUSINESS_CALENDAR_HPP
+#define BUSINESS_CALENDAR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <vector>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+#include "bit_utilities.hpp"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+/* The business_calendar class answers business day questions for the years first_year to last_year without walking the days.
+
+Every year owns a 384 bit slot (six words) holding a set bit for each business day, indexed by day of the year. The bits past
+the end of a year are never set, so the slots together read as one bitset that scans can run through across year ends.
+A running count of business days per year lets counts and additions skip whole years, so every query touches at most
+the words of two years: counts are popcounts, next and previous are bit scans. */
+
+namespace dt0
+{
+	namespace detail
+	{
+		struct byte_select_table
+		{
+			unsigned char positions[8][256];
+		};
+
+		/* positions[r][b] is the bit index of the r-th set bit of b */
+		___nodiscard___ ___constexpr14___ byte_select_table make_byte_select_table() noexcept
+		{
+			byte_select_table table{};
+
+			for (unsigned int b = 0; b < 256; ++b)
+			{
+				unsigned int rank = 0;
+
+				for (unsigned int bit = 0; bit < 8; ++bit)
+				{
+					if ((b >> bit) & 1)
+						table.positions[rank++][b] = static_cast<unsigned char>(bit);
+				}
+			}
+
+			return table;
+		}
+
+		inline ___constexpr___ byte_select_table select_in_byte = make_byte_select_table();
+	}
+
+	class business_calendar
+	{
+	public:
+		/* Week indexes of the weekend, 1 is Monday and 7 is Sunday */
+		business_calendar(std::int64_t first_year, std::int64_t last_year, std::initializer_list<unsigned short int> weekend = { 6, 7 }) :
+			_first_year(first_year), _last_year(last_year), _weekend(0)
+		{
+			if (first_year > last_year)
+				throw basic_error("Invalid business calendar range!");
+
+			for (const unsigned short int weekday : weekend)
+			{
+				if ((weekday < 1) || (weekday > 7))
+					throw basic_error("Invalid week index!");
+
+				_weekend = static_cast<unsigned char>(_weekend | (1u << weekday));
+			}
+
+			const std::size_t years = static_cast<std::size_t>(last_year - first_year + 1);
+
+			_words.assign(years * slot_words, 0);
+			_cumulative.assign(years + 1, 0);
+			_year_starts.resize(years);
+
+			for (std::size_t i = 0; i < years; ++i)
+			{
+				const std::int64_t y = first_year + static_cast<std::int64_t>(i);
+				const unsigned int length = is_leap_year(y) ? 366 : 365;
+
+				_year_starts[i] = days_from_civil(y, 1, 1);
+
+				unsigned int weekday = weekday_from_days(_year_starts[i]);
+
+				for (unsigned int d = 0; d < length; ++d)
+				{
+					if (((_weekend >> weekday) & 1) == 0)
+						_words[i * slot_words + d / 64] |= static_cast<std::uint64_t>(1) << (d % 64);
+
+					weekday = (weekday == 7) ? 1 : (weekday + 1);
+				}
+			}
+
+			_recount(0);
+		}
+
+		business_calendar(const business_calendar&) = default;
+		business_calendar(business_calendar&&) noexcept = default;
+		business_calendar& operator= (const business_calendar&) = default;
+		business_calendar& operator= (business_calendar&&) noexcept = default;
+
+		~business_calendar() noexcept = default;
+
+		___nodiscard___ std::int64_t first_year() const noexcept
+		{
+			return _first_year;
+		}
+
+		___nodiscard___ std::int64_t last_year() const noexcept
+		{
+			return _last_year;
+		}
+
+		void add_holiday(const date& d)
+		{
+			const std::size_t position = _position(d.days_since_epoch());
+
+			_words[position / 64] &= ~(static_cast<std::uint64_t>(1) << (position % 64));
+			_recount(position / slot_bits);
+		}
+
+		/* A removed holiday that falls on the weekend stays a day off */
+		void remove_holiday(const date& d)
+		{
+			const std::size_t position = _position(d.days_since_epoch());
+
+			if (((_weekend >> d.weekday()) & 1) != 0)
+				return;
+
+			_words[position / 64] |= static_cast<std::uint64_t>(1) << (position % 64);
+			_recount(position / slot_bits);
+		}
+
+		/* The queries take serial day numbers (1970-01-01 is day 0) so hot paths skip building dates, the date overloads wrap them */
+		___nodiscard___ bool is_business_day(std::int64_t days) const
+		{
+			const std::size_t position = _position(days);
+
+			return ((_words[position / 64] >> (position % 64)) & 1) != 0;
+		}
+
+		___nodiscard___ bool is_business_day(const date& d) const
+		{
+			return is_business_day(d.days_since_epoch());
+		}
+
+		/* Business days from first up to but not including last, negative when last comes before first. Either bound may be
+		the day after the calendar's last day so the whole calendar can be counted. */
+		___nodiscard___ std::int64_t count(std::int64_t first, std::int64_t last) const
+		{
+			return _bound_rank(last) - _bound_rank(first);
+		}
+
+		___nodiscard___ std::int64_t count(const date& first, const date& last) const
+		{
+			return count(first.days_since_epoch(), last.days_since_epoch());
+		}
+
+		/* The business day count business days after the given day (or before it when count is negative), the day itself for 0 */
+		___nodiscard___ std::int64_t add_business_days(std::int64_t days, std::int64_t count) const
+		{
+			const std::size_t position = _position(days);
+
+			if (count == 0)
+				return days;
+
+			const std::int64_t rank = (count > 0) ? (_rank(position + 1) + count - 1) : (_rank(position) + count);
+
+			if ((rank < 0) || (rank >= _cumulative.back()))
+				throw basic_error("No business day within the business calendar!");
+
+			const std::size_t result = _select(rank);
+
+			return _year_starts[result / slot_bits] + static_cast<std::int64_t>(result % slot_bits);
+		}
+
+		___nodiscard___ date add_business_days(const date& d, std::int64_t count) const
+		{
+			return date::from_days(add_business_days(d.days_since_epoch(), count));
+		}
+
+		/* The first business day after the given day */
+		___nodiscard___ std::int64_t next(std::int64_t days) const
+		{
+			return add_business_days(days, 1);
+		}
+
+		___nodiscard___ date next(const date& d) const
+		{
+			return add_business_days(d, 1);
+		}
+
+		/* The last business day before the given day */
+		___nodiscard___ std::int64_t previous(std::int64_t days) const
+		{
+			return add_business_days(days, -1);
+		}
+
+		___nodiscard___ date previous(const date& d) const
+		{
+			return add_business_days(d, -1);
+		}
+
+	private:
+		static ___constexpr___ std::size_t slot_words = 6;
+		static ___constexpr___ std::size_t slot_bits = slot_words * 64;
+
+		/* The day after the calendar's last day */
+		___nodiscard___ std::int64_t _end() const noexcept
+		{
+			return _year_starts.back() + (is_leap_year(_last_year) ? 366 : 365);
+		}
+
+		___nodiscard___ std::size_t _position(std::int64_t days) const
+		{
+			if ((days < _year_starts.front()) || (days >= _end()))
+				throw basic_error("Date outside of the business calendar!");
+
+			/* Years have at least 365 days, so this undershoots by at most a year every few centuries */
+			std::size_t slot = static_cast<std::size_t>((days - _year_starts.front()) / 366);
+
+			while ((slot + 1 < _year_starts.size()) && (days >= _year_starts[slot + 1]))
+				++slot;
+
+			return slot * slot_bits + static_cast<std::size_t>(days - _year_starts[slot]);
+		}
+
+		/* Business days before the day, the end of the calendar ranks after every business day */
+		___nodiscard___ std::int64_t _bound_rank(std::int64_t days) const
+		{
+			return (days == _end()) ? _cumulative.back() : _rank(_position(days));
+		}
+
+		/* Business days before position */
+		___nodiscard___ std::int64_t _rank(std::size_t position) const noexcept
+		{
+			const std::size_t slot = position / slot_bits;
+			const std::size_t word = position / 64;
+			const unsigned int bit = static_cast<unsigned int>(position % 64);
+
+			std::int64_t rank = _cumulative[slot];
+
+			for (std::size_t i = slot * slot_words; i < word; ++i)
+				rank += detail::popcount64(_words[i]);
+
+			if (bit != 0)
+				rank += detail::popcount64(_words[word] & ((static_cast<std::uint64_t>(1) << bit) - 1));
+
+			return rank;
+		}
+
+		/* Position of the business day with the given rank, which has to exist */
+		___nodiscard___ std::size_t _select(std::int64_t rank) const noexcept
+		{
+			const std::size_t slot = static_cast<std::size_t>(std::upper_bound(_cumulative.begin(), _cumulative.end(), rank) - _cumulative.begin()) - 1;
+
+			std::int64_t remaining = rank - _cumulative[slot];
+			std::size_t i = slot * slot_words;
+
+			for (;; ++i)
+			{
+				const std::int64_t bits = detail::popcount64(_words[i]);
+
+				if (remaining < bits)
+					break;
+
+				remaining -= bits;
+			}
+
+#if defined(__BMI2__)
+			return i * 64 + detail::count_trailing_zeros(_pdep_u64(static_cast<std::uint64_t>(1) << remaining, _words[i]));
+#else
+			/* Broadword select: running byte counts pick the byte without branching, a table picks the bit inside it */
+			const std::uint64_t word = _words[i];
+
+			std::uint64_t counts = word - ((word >> 1) & 0x5555555555555555ull);
+			counts = (counts & 0x3333333333333333ull) + ((counts >> 2) & 0x3333333333333333ull);
+			counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+
+			const std::uint64_t sums = counts * 0x0101010101010101ull;
+			const std::uint64_t below = (((static_cast<std::uint64_t>(remaining) * 0x0101010101010101ull) | 0x8080808080808080ull) - sums) & 0x8080808080808080ull;
+			const unsigned int shift = static_cast<unsigned int>(((below >> 7) * 0x0101010101010101ull) >> 56) * 8;
+			const unsigned int rest = static_cast<unsigned int>(remaining) - static_cast<unsigned int>(((sums << 8) >> shift) & 0xFF);
+
+			return i * 64 + shift + detail::select_in_byte.positions[rest][(word >> shift) & 0xFF];
+#endif
+		}
+
+		/* Rebuilds the running counts from a slot on */
+		void _recount(std::size_t slot) noexcept
+		{
+			for (; slot + 1 < _cumulative.size(); ++slot)
+			{
+				std::int64_t bits = 0;
+
+				for (std::size_t i = slot * slot_words; i < (slot + 1) * slot_words; ++i)
+					bits += detail::popcount64(_words[i]);
+
+				_cumulative[slot + 1] = _cumulative[slot] + bits;
+			}
+		}
+
+		std::int64_t _first_year;
+		std::int64_t _last_year;
+		unsigned char _weekend;
+		std::vector<std::uint64_t> _words;
+		std::vector<std::int64_t> _cumulative;
+		std::vector<std::int64_t> _year_starts;
+	};
+}
+
+#endif /* BUSINESS_CALENDAR_HPP */
@@ -0,0 +1,125 @@
+#ifndef CLOCK_SERVICE_HPP
+#define CLOCK_SERVICE_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+
+/* The clock_service class keeps a cached clock reading that a background thread refreshes
+at a fixed granularity, so hot threads can get the current time with a single relaxed atomic load
+instead of a clock read and a time zone lookup.
+
+Use dt0::clock_service::instance() for the shared 1 ms service or construct your own with a
+different granularity (in ticks) and clock source. The readings are never older than one granularity. */
+
+namespace dt0
+{
+	class clock_service
+	{
+	public:
+		explicit clock_service(std::int64_t granularity = ticks_per_millisecond, clock_source source = clock_source::realtime) :
+			_granularity(granularity), _source(source), _utc(0), _local(0), _stop(false)
+		{
+			if (granularity < 1)
+				throw basic_error("Invalid clock service granularity!");
+
+			_refresh();
+
+			_worker = std::thread([this]() { _run(); });
+		}
+
+		clock_service(const clock_service&) = delete;
+		clock_service(clock_service&&) = delete;
+		const clock_service& operator= (const clock_service&) = delete;
+		const clock_service& operator= (clock_service&&) = delete;
+
+		~clock_service() noexcept
+		{
+			{
+				std::lock_guard<std::mutex> _lock(_mutex);
+
+				_stop = true;
+			}
+
+			_wake.notify_one();
+
+			if (_worker.joinable())
+				_worker.join();
+		}
+
+		___nodiscard___ static clock_service& instance()
+		{
+			static clock_service service;
+
+			return service;
+		}
+
+		___nodiscard___ std::int64_t granularity() const noexcept
+		{
+			return _granularity;
+		}
+
+		___nodiscard___ clock_source source() const noexcept
+		{
+			return _source;
+		}
+
+		___nodiscard___ std::int64_t utc_ticks() const noexcept
+		{
+			return _utc.load(std::memory_order_relaxed);
+		}
+
+		___nodiscard___ std::int64_t local_ticks() const noexcept
+		{
+			return _local.load(std::memory_order_relaxed);
+		}
+
+		___nodiscard___ timestamp utc_now() const noexcept
+		{
+			return timestamp(utc_ticks());
+		}
+
+		___nodiscard___ timestamp now() const noexcept
+		{
+			return timestamp(local_ticks());
+		}
+
+	private:
+		void _refresh() noexcept
+		{
+			const std::int64_t utc = dt0::utc_ticks(_source);
+
+			_utc.store(utc, std::memory_order_relaxed);
+			_local.store(utc + local_offset_ticks(utc), std::memory_order_relaxed);
+		}
+
+		void _run()
+		{
+			const std::chrono::nanoseconds period(_granularity * 100);
+
+			std::unique_lock<std::mutex> _lock(_mutex);
+
+			while (!_wake.wait_for(_lock, period, [this]() { return _stop; }))
+				_refresh();
+		}
+
+		const std::int64_t _granularity;
+		const clock_source _source;
+
+		std::atomic<std::int64_t> _utc;
+		std::atomic<std::int64_t> _local;
+
+		bool _stop;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::thread _worker;
+	};
+}
+
+#endif /* CLOCK_SERVICE_HPP */
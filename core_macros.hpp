@@ -97,4 +97,68 @@
 	#endif
 #endif
 
+#ifndef ___cpp20___
+	#ifdef _MSVC_LANG
+		#if _MSVC_LANG > 201703L
+			#define ___cpp20___ 1
+		#else
+			#define ___cpp20___ 0
+		#endif
+	#else
+		#if __cplusplus > 201703L
+			#define ___cpp20___ 1
+		#else
+			#define ___cpp20___ 0
+		#endif
+	#endif
+#endif
+
+#ifndef ___x86___
+	#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+		#define ___x86___ 1
+	#else
+		#define ___x86___ 0
+	#endif
+#endif
+
+#ifndef ___big_endian___
+	#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+		#define ___big_endian___ 1
+	#else
+		#define ___big_endian___ 0
+	#endif
+#endif
+
+#ifndef ___sse2___
+	#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+		#define ___sse2___ 1
+	#else
+		#define ___sse2___ 0
+	#endif
+#endif
+
+#ifndef ___ssse3___
+	#if defined(__SSSE3__) || defined(__AVX__)
+		#define ___ssse3___ 1
+	#else
+		#define ___ssse3___ 0
+	#endif
+#endif
+
+#ifndef ___avx2___
+	#if defined(__AVX2__)
+		#define ___avx2___ 1
+	#else
+		#define ___avx2___ 0
+	#endif
+#endif
+
+#ifndef ___noinline___
+	#if defined(_MSC_VER) && !defined(__clang__)
+		#define ___noinline___ __declspec(noinline)
+	#else
+		#define ___noinline___ __attribute__((noinline))
+	#endif
+#endif
+
 #endif /* CORE_MACROS_HPP */
@@ -0,0 +1,620 @@
+#ifndef DATE_COLUMN_HPP
+#define DATE_COLUMN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include "core_macros.hpp"
+#include "date_time.hpp"
+
+#if ___avx2___
+#include <immintrin.h>
+#endif
+
+/* The date_column class stores timestamps as a structure of arrays, a single contiguous run of tick counts.
+Whole columns of years, months, days, week indexes and hours are extracted with the kernels below
+instead of building a date_time per row, date_time objects are only built when a row is asked for.
+
+The kernels are free functions over plain tick arrays so they work on any contiguous storage (a mapped file, a vector of timestamps).
+With AVX2 they convert eight ticks per step, the split into days and time of day is done on doubles where every
+intermediate value is an integer below 2^53 and the calendar fields on 32 bit lanes, so the results are exact. */
+
+namespace dt0
+{
+	namespace detail
+	{
+		enum class column_field
+		{
+			year,
+			month,
+			day,
+			weekday,
+			hour
+		};
+
+		template <column_field F>
+		inline std::int64_t extract_field(std::int64_t ticks) noexcept
+		{
+			const std::int64_t days = days_from_ticks(ticks);
+
+			switch (F)
+			{
+			case column_field::year:
+				return civil_from_days(days).y;
+
+			case column_field::month:
+				return civil_from_days(days).m;
+
+			case column_field::day:
+				return civil_from_days(days).d;
+
+			case column_field::weekday:
+				return weekday_from_days(days);
+
+			default:
+				return (ticks - days * ticks_per_day) / ticks_per_hour;
+			}
+		}
+
+#if ___avx2___
+		/* floor(a / d) for integer valued lanes, the product q * d and the remainder must stay below 2^53 */
+		inline __m256d floor_div_pd(__m256d a, double d) noexcept
+		{
+			const __m256d divisor = _mm256_set1_pd(d);
+			const __m256d one = _mm256_set1_pd(1.0);
+
+			__m256d q = _mm256_floor_pd(_mm256_mul_pd(a, _mm256_set1_pd(1.0 / d)));
+			const __m256d r = _mm256_sub_pd(a, _mm256_mul_pd(q, divisor));
+
+			q = _mm256_add_pd(q, _mm256_and_pd(_mm256_cmp_pd(r, divisor, _CMP_GE_OQ), one));
+			q = _mm256_sub_pd(q, _mm256_and_pd(_mm256_cmp_pd(r, _mm256_setzero_pd(), _CMP_LT_OQ), one));
+
+			return q;
+		}
+
+		/* Splits four tick counts into days since the epoch and ticks into the day.
+		ticks_per_day is 2^14 * 52734375, the 2^14 part is a logical shift of the sign flipped ticks
+		which leaves a value below 2^50 that converts to a double exactly through the 2^52 exponent trick. */
+		inline void split_ticks_pd(const std::int64_t* ticks, __m256d& days, __m256d& tod) noexcept
+		{
+			const __m256i t = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks));
+			const __m256i exponent = _mm256_castpd_si256(_mm256_set1_pd(4503599627370496.0));
+
+			const __m256i shifted = _mm256_srli_epi64(_mm256_xor_si256(t, _mm256_set1_epi64x(INT64_MIN)), 14);
+			const __m256i low = _mm256_and_si256(t, _mm256_set1_epi64x(0x3FFF));
+
+			const __m256d w = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(shifted, exponent)), _mm256_set1_pd(4503599627370496.0 + 562949953421312.0));
+			const __m256d l = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(low, exponent)), _mm256_set1_pd(4503599627370496.0));
+
+			days = floor_div_pd(w, 52734375.0);
+			tod = _mm256_add_pd(_mm256_mul_pd(_mm256_sub_pd(w, _mm256_mul_pd(days, _mm256_set1_pd(52734375.0))), _mm256_set1_pd(16384.0)), l);
+		}
+
+		/* floor(x / d) on eight unsigned lanes where magic = ceil(2^shift / d) is exact over the lanes' range */
+		inline __m256i div_epu32(__m256i x, std::uint32_t magic, int shift) noexcept
+		{
+			const __m256i m = _mm256_set1_epi64x(magic);
+			const __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, m), shift);
+			const __m256i odd = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(x, 32), m), shift);
+
+			return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+		}
+
+		/* Eight days since the epoch as int32 lanes */
+		inline __m256i split_days_epi32(const std::int64_t* ticks) noexcept
+		{
+			__m256d low_days, low_tod, high_days, high_tod;
+
+			split_ticks_pd(ticks, low_days, low_tod);
+			split_ticks_pd(ticks + 4, high_days, high_tod);
+
+			return _mm256_set_m128i(_mm256_cvtpd_epi32(high_days), _mm256_cvtpd_epi32(low_days));
+		}
+
+		/* Neri and Schneider's civil_from_days on eight 32 bit lanes. The days are shifted by 82 eras (12699422 days)
+		so every lane is unsigned, which covers every day a timestamp can hold, the magic numbers were checked over that range. */
+		template <column_field F>
+		inline __m256i civil_field_epi32(__m256i days) noexcept
+		{
+			const __m256i n = _mm256_add_epi32(days, _mm256_set1_epi32(12699422));
+
+			if (F == column_field::weekday)
+			{
+				const __m256i shifted = _mm256_add_epi32(n, _mm256_set1_epi32(2));
+				const __m256i weeks = div_epu32(shifted, 153391690u, 30);
+
+				return _mm256_add_epi32(_mm256_sub_epi32(shifted, _mm256_mullo_epi32(weeks, _mm256_set1_epi32(7))), _mm256_set1_epi32(1));
+			}
+
+			const __m256i n1 = _mm256_add_epi32(_mm256_slli_epi32(n, 2), _mm256_set1_epi32(3));
+			const __m256i century = div_epu32(n1, 15051803u, 41);
+			const __m256i n2 = _mm256_or_si256(_mm256_sub_epi32(n1, _mm256_mullo_epi32(century, _mm256_set1_epi32(146097))), _mm256_set1_epi32(3));
+			const __m256i yoc = div_epu32(n2, 2939745u, 32);
+			const __m256i doy = _mm256_srli_epi32(_mm256_sub_epi32(n2, _mm256_mullo_epi32(yoc, _mm256_set1_epi32(1461))), 2);
+			const __m256i n3 = _mm256_add_epi32(_mm256_mullo_epi32(doy, _mm256_set1_epi32(2141)), _mm256_set1_epi32(197913));
+
+			/* days from March 1st past 305 are in January or February of the next year */
+			const __m256i late = _mm256_cmpgt_epi32(doy, _mm256_set1_epi32(305));
+
+			if (F == column_field::day)
+			{
+				const __m256i in_month = _mm256_and_si256(n3, _mm256_set1_epi32(0xFFFF));
+
+				return _mm256_add_epi32(_mm256_srli_epi32(_mm256_mullo_epi32(in_month, _mm256_set1_epi32(62690)), 27), _mm256_set1_epi32(1));
+			}
+
+			if (F == column_field::month)
+				return _mm256_add_epi32(_mm256_srli_epi32(n3, 16), _mm256_and_si256(late, _mm256_set1_epi32(-12)));
+
+			const __m256i y = _mm256_add_epi32(_mm256_mullo_epi32(century, _mm256_set1_epi32(100)), yoc);
+
+			return _mm256_sub_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(400 * 82)), late);
+		}
+
+		template <column_field F>
+		inline __m256i extract_field_epi32(const std::int64_t* ticks) noexcept
+		{
+			if (F == column_field::hour)
+			{
+				__m256d low_days, low_tod, high_days, high_tod;
+
+				split_ticks_pd(ticks, low_days, low_tod);
+				split_ticks_pd(ticks + 4, high_days, high_tod);
+
+				return _mm256_set_m128i(_mm256_cvtpd_epi32(floor_div_pd(high_tod, static_cast<double>(ticks_per_hour))),
+					_mm256_cvtpd_epi32(floor_div_pd(low_tod, static_cast<double>(ticks_per_hour))));
+			}
+
+			return civil_field_epi32<F>(split_days_epi32(ticks));
+		}
+#endif
+
+		template <column_field F>
+		inline void extract_column(const std::int64_t* ticks, std::size_t count, std::int32_t* out) noexcept
+		{
+			std::size_t i = 0;
+
+#if ___avx2___
+			for (const std::size_t blocks = count & ~static_cast<std::size_t>(7); i < blocks; i += 8)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), extract_field_epi32<F>(ticks + i));
+#endif
+
+			for (; i < count; ++i)
+				out[i] = static_cast<std::int32_t>(extract_field<F>(ticks[i]));
+		}
+
+		template <column_field F>
+		inline void extract_column(const std::int64_t* ticks, std::size_t count, std::uint8_t* out) noexcept
+		{
+			std::size_t i = 0;
+
+#if ___avx2___
+			for (const std::size_t blocks = count & ~static_cast<std::size_t>(7); i < blocks; i += 8)
+			{
+				const __m256i wide = extract_field_epi32<F>(ticks + i);
+				const __m128i narrow = _mm_packs_epi32(_mm256_castsi256_si128(wide), _mm256_extracti128_si256(wide, 1));
+
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + i), _mm_packus_epi16(narrow, narrow));
+			}
+#endif
+
+			for (; i < count; ++i)
+				out[i] = static_cast<std::uint8_t>(extract_field<F>(ticks[i]));
+		}
+	}
+
+	/* Astronomical years (1 BCE is year 0) */
+	inline void extract_years(const std::int64_t* ticks, std::size_t count, std::int32_t* out) noexcept
+	{
+		detail::extract_column<detail::column_field::year>(ticks, count, out);
+	}
+
+	inline void extract_months(const std::int64_t* ticks, std::size_t count, std::uint8_t* out) noexcept
+	{
+		detail::extract_column<detail::column_field::month>(ticks, count, out);
+	}
+
+	inline void extract_days(const std::int64_t* ticks, std::size_t count, std::uint8_t* out) noexcept
+	{
+		detail::extract_column<detail::column_field::day>(ticks, count, out);
+	}
+
+	/* Monday (1) to Sunday (7) */
+	inline void extract_weekdays(const std::int64_t* ticks, std::size_t count, std::uint8_t* out) noexcept
+	{
+		detail::extract_column<detail::column_field::weekday>(ticks, count, out);
+	}
+
+	inline void extract_hours(const std::int64_t* ticks, std::size_t count, std::uint8_t* out) noexcept
+	{
+		detail::extract_column<detail::column_field::hour>(ticks, count, out);
+	}
+
+	namespace detail
+	{
+#if ___avx2___
+		/* Integer valued doubles below 2^51 in magnitude to int64 lanes through the 1.5 * 2^52 exponent trick */
+		inline __m256i cvtpd_epi64(__m256d x) noexcept
+		{
+			const __m256d magic = _mm256_set1_pd(6755399441055744.0);
+
+			return _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(x, magic)), _mm256_castpd_si256(magic));
+		}
+
+		/* Months since January 1970 for eight lanes, as two halves of four doubles */
+		inline void month_serials_pd(const std::int64_t* ticks, __m256d& low, __m256d& high) noexcept
+		{
+			const __m256i days = split_days_epi32(ticks);
+			const __m256i y = civil_field_epi32<column_field::year>(days);
+			const __m256i m = civil_field_epi32<column_field::month>(days);
+			const __m256i serial = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_sub_epi32(y, _mm256_set1_epi32(1970)), _mm256_set1_epi32(12)), _mm256_sub_epi32(m, _mm256_set1_epi32(1)));
+
+			low = _mm256_cvtepi32_pd(_mm256_castsi256_si128(serial));
+			high = _mm256_cvtepi32_pd(_mm256_extracti128_si256(serial, 1));
+		}
+
+		/* Four fixed width bucket ids of at least a millisecond that either divide a day (per_day windows each) or span whole days */
+		inline __m256i fixed_bucket_epi64(const std::int64_t* ticks, __m256i origin, std::int64_t width, double per_day, double width_days) noexcept
+		{
+			std::int64_t _shifted[4];
+
+			_mm256_storeu_si256(reinterpret_cast<__m256i*>(_shifted), _mm256_sub_epi64(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(ticks)), origin));
+
+			__m256d days, tod;
+
+			split_ticks_pd(_shifted, days, tod);
+
+			if (width_days != 0.0)
+				return cvtpd_epi64(floor_div_pd(days, width_days));
+
+			return cvtpd_epi64(_mm256_add_pd(_mm256_mul_pd(days, _mm256_set1_pd(per_day)), floor_div_pd(tod, static_cast<double>(width))));
+		}
+#endif
+
+		template <time_unit U>
+		inline void bucket_column(const std::int64_t* ticks, std::size_t count, std::int64_t* out) noexcept
+		{
+			std::size_t i = 0;
+
+#if ___avx2___
+			for (const std::size_t blocks = count & ~static_cast<std::size_t>(7); i < blocks; i += 8)
+			{
+				__m256d low, high;
+
+				if ((U == time_unit::month) || (U == time_unit::quarter) || (U == time_unit::year))
+				{
+					month_serials_pd(ticks + i, low, high);
+
+					if (U != time_unit::month)
+					{
+						low = floor_div_pd(low, (U == time_unit::quarter) ? 3.0 : 12.0);
+						high = floor_div_pd(high, (U == time_unit::quarter) ? 3.0 : 12.0);
+					}
+				}
+
+				else
+				{
+					__m256d low_tod, high_tod;
+
+					split_ticks_pd(ticks + i, low, low_tod);
+					split_ticks_pd(ticks + i + 4, high, high_tod);
+
+					if (U == time_unit::week)
+					{
+						low = floor_div_pd(_mm256_add_pd(low, _mm256_set1_pd(3.0)), 7.0);
+						high = floor_div_pd(_mm256_add_pd(high, _mm256_set1_pd(3.0)), 7.0);
+					}
+
+					else if (U != time_unit::day)
+					{
+						const double width = static_cast<double>(bucket_start(1, U));
+						const __m256d per_day = _mm256_set1_pd(static_cast<double>(ticks_per_day / bucket_start(1, U)));
+
+						low = _mm256_add_pd(_mm256_mul_pd(low, per_day), floor_div_pd(low_tod, width));
+						high = _mm256_add_pd(_mm256_mul_pd(high, per_day), floor_div_pd(high_tod, width));
+					}
+				}
+
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), cvtpd_epi64(low));
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i + 4), cvtpd_epi64(high));
+			}
+#endif
+
+			for (; i < count; ++i)
+				out[i] = bucket_of(ticks[i], U);
+		}
+	}
+
+	/* Calendar aligned bucket ids, the same values bucket_of() returns for each tick */
+	inline void bucket_ticks(const std::int64_t* ticks, std::size_t count, time_unit unit, std::int64_t* out) noexcept
+	{
+		switch (unit)
+		{
+		case time_unit::millisecond:
+			return detail::bucket_column<time_unit::millisecond>(ticks, count, out);
+
+		case time_unit::second:
+			return detail::bucket_column<time_unit::second>(ticks, count, out);
+
+		case time_unit::minute:
+			return detail::bucket_column<time_unit::minute>(ticks, count, out);
+
+		case time_unit::hour:
+			return detail::bucket_column<time_unit::hour>(ticks, count, out);
+
+		case time_unit::day:
+			return detail::bucket_column<time_unit::day>(ticks, count, out);
+
+		case time_unit::week:
+			return detail::bucket_column<time_unit::week>(ticks, count, out);
+
+		case time_unit::month:
+			return detail::bucket_column<time_unit::month>(ticks, count, out);
+
+		case time_unit::quarter:
+			return detail::bucket_column<time_unit::quarter>(ticks, count, out);
+
+		default:
+			return detail::bucket_column<time_unit::year>(ticks, count, out);
+		}
+	}
+
+	/* Fixed width windows aligned on origin, the same values bucket_of(ticks, width, origin) returns.
+	The AVX2 path takes widths of at least a millisecond that divide a day or are a whole number of days, the rest run scalar. */
+	inline void bucket_ticks(const std::int64_t* ticks, std::size_t count, std::int64_t width, std::int64_t origin, std::int64_t* out) noexcept
+	{
+		std::size_t i = 0;
+
+#if ___avx2___
+		const bool divides_day = (width >= ticks_per_millisecond) && ((ticks_per_day % width) == 0);
+		const bool whole_days = (width >= ticks_per_day) && ((width % ticks_per_day) == 0);
+
+		if (divides_day || whole_days)
+		{
+			const __m256i _origin = _mm256_set1_epi64x(origin);
+			const double per_day = divides_day ? static_cast<double>(ticks_per_day / width) : 0.0;
+			const double width_days = whole_days ? static_cast<double>(width / ticks_per_day) : 0.0;
+
+			for (const std::size_t blocks = count & ~static_cast<std::size_t>(3); i < blocks; i += 4)
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), detail::fixed_bucket_epi64(ticks + i, _origin, width, per_day, width_days));
+		}
+#endif
+
+		for (; i < count; ++i)
+			out[i] = bucket_of(ticks[i], width, origin);
+	}
+
+	namespace detail
+	{
+		/* Biased so that unsigned order matches signed order */
+		___nodiscard___ ___constexpr___ std::uint64_t radix_key(std::int64_t ticks) noexcept
+		{
+			return static_cast<std::uint64_t>(ticks) ^ 0x8000000000000000ull;
+		}
+
+		struct keyed_index
+		{
+			std::uint64_t key;
+			std::size_t index;
+		};
+
+		/* LSD radix sort on 11 bit digits, stable. Keys are taken relative to the smallest one and only the digits
+		the range spans are sorted, a batch covering a year of ticks needs five passes instead of six. All histograms
+		come from a single read of the input. */
+		template <class T, class Key>
+		inline void radix_sort_by(T* first, T* last, T* buffer, Key key)
+		{
+			const std::size_t count = static_cast<std::size_t>(last - first);
+
+			if (count < 2)
+				return;
+
+			std::uint64_t low = key(first[0]);
+			std::uint64_t high = low;
+
+			for (std::size_t i = 1; i < count; ++i)
+			{
+				const std::uint64_t k = key(first[i]);
+
+				low = (k < low) ? k : low;
+				high = (k > high) ? k : high;
+			}
+
+			unsigned int passes = 0;
+
+			for (std::uint64_t range = high - low; range != 0; range >>= 11)
+				++passes;
+
+			std::vector<std::size_t> _counts(static_cast<std::size_t>(passes) << 11);
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				const std::uint64_t k = key(first[i]) - low;
+
+				for (unsigned int pass = 0; pass < passes; ++pass)
+					++_counts[(static_cast<std::size_t>(pass) << 11) + ((k >> (11 * pass)) & 0x7FF)];
+			}
+
+			T* from = first;
+			T* to = buffer;
+
+			for (unsigned int pass = 0; pass < passes; ++pass)
+			{
+				std::size_t* const offsets = _counts.data() + (static_cast<std::size_t>(pass) << 11);
+				const unsigned int shift = 11 * pass;
+				std::size_t offset = 0;
+
+				for (unsigned int digit = 0; digit < 2048; ++digit)
+				{
+					const std::size_t c = offsets[digit];
+					offsets[digit] = offset;
+					offset += c;
+				}
+
+				for (std::size_t i = 0; i < count; ++i)
+					to[offsets[((key(from[i]) - low) >> shift) & 0x7FF]++] = from[i];
+
+				std::swap(from, to);
+			}
+
+			if (from != first)
+				std::copy(from, from + count, first);
+		}
+	}
+
+	/* Ascending and stable, all three need a scratch buffer the size of the input */
+
+	inline void radix_sort(std::int64_t* first, std::int64_t* last)
+	{
+		std::vector<std::int64_t> _buffer(static_cast<std::size_t>(last - first));
+
+		detail::radix_sort_by(first, last, _buffer.data(), [](std::int64_t value) noexcept { return detail::radix_key(value); });
+	}
+
+	inline void radix_sort(timestamp* first, timestamp* last)
+	{
+		std::vector<timestamp> _buffer(static_cast<std::size_t>(last - first));
+
+		detail::radix_sort_by(first, last, _buffer.data(), [](timestamp value) noexcept { return detail::radix_key(value.ticks()); });
+	}
+
+	/* date_time is 32 bytes, so the passes move (tick key, position) pairs and the values are gathered once at the end */
+	inline void radix_sort(date_time* first, date_time* last)
+	{
+		const std::size_t count = static_cast<std::size_t>(last - first);
+
+		std::vector<detail::keyed_index> _keys(count);
+		std::vector<detail::keyed_index> _buffer(count);
+
+		for (std::size_t i = 0; i < count; ++i)
+			_keys[i] = detail::keyed_index{ detail::radix_key(first[i].ticks()), i };
+
+		detail::radix_sort_by(_keys.data(), _keys.data() + count, _buffer.data(), [](const detail::keyed_index& value) noexcept { return value.key; });
+
+		std::vector<date_time> _sorted(count);
+
+		for (std::size_t i = 0; i < count; ++i)
+			_sorted[i] = first[_keys[i].index];
+
+		std::copy(_sorted.begin(), _sorted.end(), first);
+	}
+
+	class date_column
+	{
+	public:
+		using size_type = std::size_t;
+
+		date_column() noexcept = default;
+
+		explicit date_column(std::vector<std::int64_t> ticks) noexcept : _ticks(std::move(ticks)) {}
+
+		date_column(const timestamp* first, size_type count) : _ticks(count)
+		{
+			static_assert(sizeof(timestamp) == sizeof(std::int64_t), "timestamp must stay a single 64 bit word");
+
+			if (count != 0)
+				std::memcpy(_ticks.data(), first, count * sizeof(std::int64_t));
+		}
+
+		date_column(const date_column&) = default;
+		date_column(date_column&&) noexcept = default;
+		date_column& operator= (const date_column&) = default;
+		date_column& operator= (date_column&&) noexcept = default;
+
+		~date_column() noexcept = default;
+
+		___nodiscard___ size_type size() const noexcept
+		{
+			return _ticks.size();
+		}
+
+		___nodiscard___ bool empty() const noexcept
+		{
+			return _ticks.empty();
+		}
+
+		___nodiscard___ const std::int64_t* data() const noexcept
+		{
+			return _ticks.data();
+		}
+
+		void reserve(size_type count)
+		{
+			_ticks.reserve(count);
+		}
+
+		void clear() noexcept
+		{
+			_ticks.clear();
+		}
+
+		void push_back(timestamp value)
+		{
+			_ticks.push_back(value.ticks());
+		}
+
+		void push_back(const date_time& value)
+		{
+			_ticks.push_back(timestamp(value).ticks());
+		}
+
+		___nodiscard___ timestamp operator[] (size_type index) const noexcept
+		{
+			return timestamp(_ticks[index]);
+		}
+
+		___nodiscard___ date_time get(size_type index) const
+		{
+			return timestamp(_ticks[index]).to_date_time();
+		}
+
+		/* Each of these writes size() values to out */
+
+		void years(std::int32_t* out) const noexcept
+		{
+			extract_years(_ticks.data(), _ticks.size(), out);
+		}
+
+		void months(std::uint8_t* out) const noexcept
+		{
+			extract_months(_ticks.data(), _ticks.size(), out);
+		}
+
+		void days(std::uint8_t* out) const noexcept
+		{
+			extract_days(_ticks.data(), _ticks.size(), out);
+		}
+
+		void weekdays(std::uint8_t* out) const noexcept
+		{
+			extract_weekdays(_ticks.data(), _ticks.size(), out);
+		}
+
+		void hours(std::uint8_t* out) const noexcept
+		{
+			extract_hours(_ticks.data(), _ticks.size(), out);
+		}
+
+		void buckets(time_unit unit, std::int64_t* out) const noexcept
+		{
+			bucket_ticks(_ticks.data(), _ticks.size(), unit, out);
+		}
+
+		void buckets(std::int64_t width, std::int64_t origin, std::int64_t* out) const noexcept
+		{
+			bucket_ticks(_ticks.data(), _ticks.size(), width, origin, out);
+		}
+
+		void sort()
+		{
+			radix_sort(_ticks.data(), _ticks.data() + _ticks.size());
+		}
+
+	private:
+		std::vector<std::int64_t> _ticks;
+	};
+}
+
+#endif /* DATE_COLUMN_HPP */
@@ -0,0 +1,248 @@
+#ifndef DATE_RANGE_HPP
+#define DATE_RANGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+
+#if ___cpp20___
+#include <ranges>
+#endif
+
+/* The date_range class is a lazy view over the dates from first up to but not including last,
+stepping by a number of days, weeks, months, quarters or years. Month based steps keep the day of month of first
+and clamp it to shorter months, so monthly from January 31 gives February 29, March 31, April 30 and so on.
+
+Nothing is stored per step, the iterator keeps a serial day number and builds each date when it is dereferenced.
+It is a forward range in C++20 (and a borrowed view, iterators do not point into the range) and works with range-for in C++17:
+
+	for (const dt0::date& d : dt0::date_range(first, last).on(1))	every Monday
+	for (const dt0::date& d : dt0::date_range(first, last, 1, dt0::time_unit::month))	every month */
+
+namespace dt0
+{
+	class date_range
+	{
+	public:
+		struct sentinel {};
+
+		class iterator
+		{
+		public:
+			using value_type = date;
+			using difference_type = std::ptrdiff_t;
+			using reference = date;
+			using pointer = void;
+			using iterator_category = std::input_iterator_tag;
+			using iterator_concept = std::forward_iterator_tag;
+
+			___constexpr___ iterator() noexcept : _current(0), _end(0), _step_days(0), _step_months(0), _months(0), _anchor_day(0), _weekdays(0) {}
+
+			___nodiscard___ date operator* () const
+			{
+				return date::from_days(_current);
+			}
+
+			/* The serial day number of the current date, 1970-01-01 is day 0 */
+			___nodiscard___ ___constexpr___ std::int64_t days_since_epoch() const noexcept
+			{
+				return _current;
+			}
+
+			iterator& operator++ () noexcept
+			{
+				do
+				{
+					_advance();
+				} while ((_current < _end) && !_selected());
+
+				return *this;
+			}
+
+			iterator operator++ (int) noexcept
+			{
+				iterator _previous = *this;
+
+				++*this;
+
+				return _previous;
+			}
+
+			___nodiscard___ ___constexpr___ bool operator== (const iterator& other) const noexcept
+			{
+				return (_current == other._current) || ((_current >= _end) && (other._current >= other._end));
+			}
+
+			___nodiscard___ ___constexpr___ bool operator!= (const iterator& other) const noexcept
+			{
+				return !(*this == other);
+			}
+
+			/* C++20 rewrites the other three sentinel comparisons from this one */
+			___nodiscard___ ___constexpr___ bool operator== (sentinel) const noexcept
+			{
+				return _current >= _end;
+			}
+
+#if !___cpp20___
+			___nodiscard___ ___constexpr___ bool operator!= (sentinel) const noexcept
+			{
+				return _current < _end;
+			}
+
+			___nodiscard___ friend ___constexpr___ bool operator== (sentinel, const iterator& it) noexcept
+			{
+				return it._current >= it._end;
+			}
+
+			___nodiscard___ friend ___constexpr___ bool operator!= (sentinel, const iterator& it) noexcept
+			{
+				return it._current < it._end;
+			}
+#endif
+
+		private:
+			friend class date_range;
+
+			void _advance() noexcept
+			{
+				if (_step_months == 0)
+				{
+					_current += _step_days;
+					return;
+				}
+
+				_months += _step_months;
+
+				const std::int64_t y = 1970 + floor_div(_months, 12);
+				const unsigned int m = static_cast<unsigned int>(_months - (y - 1970) * 12 + 1);
+				const unsigned int last = days_in_month(y, m);
+
+				_current = days_from_civil(y, m, (_anchor_day < last) ? _anchor_day : last);
+			}
+
+			___nodiscard___ bool _selected() const noexcept
+			{
+				return (_weekdays >> weekday_from_days(_current)) & 1;
+			}
+
+			std::int64_t _current;
+			std::int64_t _end;
+			std::int64_t _step_days;
+			std::int64_t _step_months;
+			std::int64_t _months;
+			unsigned short int _anchor_day;
+			unsigned char _weekdays;
+		};
+
+		___constexpr20___ date_range() noexcept = default;
+
+		/* Steps of count units, only day, week, month, quarter and year are calendar steps */
+		date_range(const date& first, const date& last, std::int64_t count = 1, time_unit unit = time_unit::day)
+		{
+			if (count < 1)
+				throw basic_error("Invalid date range step!");
+
+			switch (unit)
+			{
+			case time_unit::day:
+				_first._step_days = count;
+				break;
+
+			case time_unit::week:
+				_first._step_days = 7 * count;
+				break;
+
+			case time_unit::month:
+				_first._step_months = count;
+				break;
+
+			case time_unit::quarter:
+				_first._step_months = 3 * count;
+				break;
+
+			case time_unit::year:
+				_first._step_months = 12 * count;
+				break;
+
+			default:
+				throw basic_error("Invalid date range step!");
+			}
+
+			_first._current = first.days_since_epoch();
+			_first._end = last.days_since_epoch();
+			_first._months = (first.get_year().astronomical() - 1970) * 12 + first.get_month().index() - 1;
+			_first._anchor_day = first.get_day().month_index();
+			_first._weekdays = all_weekdays;
+		}
+
+		date_range(const date_range&) noexcept = default;
+		date_range(date_range&&) noexcept = default;
+		date_range& operator= (const date_range&) noexcept = default;
+		date_range& operator= (date_range&&) noexcept = default;
+
+		~date_range() noexcept = default;
+
+		/* Keeps only the dates that fall on the given week indexes (1 is Monday, 7 is Sunday) */
+		___nodiscard___ date_range on(std::initializer_list<unsigned short int> weekdays) const
+		{
+			unsigned char mask = 0;
+
+			for (const unsigned short int weekday : weekdays)
+			{
+				if ((weekday < 1) || (weekday > 7))
+					throw basic_error("Invalid week index!");
+
+				mask = static_cast<unsigned char>(mask | (1u << weekday));
+			}
+
+			date_range _filtered = *this;
+
+			_filtered._first._weekdays = static_cast<unsigned char>(_first._weekdays & mask);
+
+			if (!_filtered._first._selected())
+				++_filtered._first;
+
+			return _filtered;
+		}
+
+		___nodiscard___ date_range on(unsigned short int weekday) const
+		{
+			return on({ weekday });
+		}
+
+		___nodiscard___ ___constexpr___ iterator begin() const noexcept
+		{
+			return _first;
+		}
+
+		___nodiscard___ ___constexpr___ sentinel end() const noexcept
+		{
+			return sentinel{};
+		}
+
+		___nodiscard___ ___constexpr___ bool empty() const noexcept
+		{
+			return _first._current >= _first._end;
+		}
+
+	private:
+		static ___constexpr___ unsigned char all_weekdays = 0xFE;
+
+		iterator _first;
+	};
+}
+
+#if ___cpp20___
+template <>
+inline constexpr bool std::ranges::enable_view<dt0::date_range> = true;
+
+template <>
+inline constexpr bool std::ranges::enable_borrowed_range<dt0::date_range> = true;
+#endif
+
+#endif /* DATE_RANGE_HPP */
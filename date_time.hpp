@@ -1,1137 +1,2608 @@
 #ifndef DATE_TIME_HPP
 #define DATE_TIME_HPP
 
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <time.h>
+#endif
+
 #include <utility>
 #include <string>
+#include <string_view>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <chrono>
+#include <system_error>
+#include <type_traits>
+#include <functional>
 #include "core_macros.hpp"
 #include "basic_error.hpp"
 
-namespace dt0
-{
-	class time
-	{
-	public:
-		___constexpr20___ time() noexcept : _hours(0), _minutes(0), _seconds(0), _milliseconds(0) {}
+#if ___cpp20___
+#include <compare>
+#endif
 
-		time(unsigned short int hours, unsigned short int minutes, unsigned short int seconds, unsigned short int milliseconds)
-		{
-			if (milliseconds > 999)
-				throw basic_error("Invalid value for milliseconds!");
+#if ___ssse3___
+#include <tmmintrin.h>
+#elif ___sse2___
+#include <emmintrin.h>
+#endif
 
-			if (seconds > 59)
-				throw basic_error("Invalid value for seconds!");
+namespace dt0
+{
+	/* Proleptic Gregorian calendar arithmetic on serial day numbers (days since 1970-01-01),
+	years are astronomical so 1 BCE is year 0, 2 BCE is year -1 and so on.
+	Week indexes run from Monday (1) to Sunday (7) like in the day class. */
 
-			if (minutes > 59)
-				throw basic_error("Invalid value for minutes!");
+	struct civil_date
+	{
+		std::int64_t y;
+		unsigned short int m;
+		unsigned short int d;
+	};
 
-			_hours = std::move(hours);
-			_minutes = std::move(minutes);
-			_seconds = std::move(seconds);
-			_milliseconds = std::move(milliseconds);
-		}
+	___nodiscard___ ___constexpr___ bool is_leap_year(std::int64_t y) noexcept
+	{
+		return ((y % 4) == 0) && (((y % 100) != 0) || ((y % 400) == 0));
+	}
 
-		time(unsigned int milliseconds)
-		{
-			_milliseconds = (milliseconds < 1000) ? milliseconds : (milliseconds % 1000);
+	___nodiscard___ ___constexpr___ unsigned short int days_in_month(std::int64_t y, unsigned int m) noexcept
+	{
+		return static_cast<unsigned short int>((m == 2) ? (28 + is_leap_year(y)) : (30 + ((m + (m >> 3)) & 1)));
+	}
 
-			_seconds = (milliseconds > 999) ? (milliseconds / 1000) : 0;
+	___nodiscard___ ___constexpr14___ std::int64_t days_from_civil(std::int64_t y, unsigned int m, unsigned int d) noexcept
+	{
+		y -= (m <= 2) ? 1 : 0;
 
-			_minutes = (_seconds > 59) ? (_seconds / 60) : 0;
+		const std::int64_t era = ((y >= 0) ? y : (y - 399)) / 400;
+		const std::int64_t yoe = y - era * 400;
+		const std::int64_t doy = (153 * ((m > 2) ? (m - 3) : (m + 9)) + 2) / 5 + d - 1;
+		const std::int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
 
-			if (_seconds > 59)
-			{
-				_seconds %= 100;
+		return era * 146097 + doe - 719468;
+	}
 
-				if (_seconds > 59) _seconds %= 10;
-			}
+	___nodiscard___ ___constexpr14___ civil_date civil_from_days(std::int64_t days) noexcept
+	{
+		days += 719468;
 
-			_hours = (_minutes > 59) ? (_minutes / 60) : 0;
+		const std::int64_t era = ((days >= 0) ? days : (days - 146096)) / 146097;
+		const std::int64_t doe = days - era * 146097;
+		const std::int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+		const std::int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+		const std::int64_t mp = (5 * doy + 2) / 153;
+		const std::int64_t m = (mp < 10) ? (mp + 3) : (mp - 9);
 
-			if (_minutes > 59)
-			{
-				_minutes %= 100;
+		return civil_date{ yoe + era * 400 + ((m <= 2) ? 1 : 0), static_cast<unsigned short int>(m), static_cast<unsigned short int>(doy - (153 * mp + 2) / 5 + 1) };
+	}
 
-				if (_minutes > 59) _minutes %= 10;
-			}
-		}
+	/* 1970-01-01 was a Thursday */
+	___nodiscard___ ___constexpr___ unsigned short int weekday_from_days(std::int64_t days) noexcept
+	{
+		return static_cast<unsigned short int>(((days % 7) + 10) % 7 + 1);
+	}
 
-		time(unsigned short int seconds)
-		{
-			_milliseconds = 0;
+	___nodiscard___ ___constexpr___ unsigned short int day_of_year(std::int64_t y, unsigned int m, unsigned int d) noexcept
+	{
+		return static_cast<unsigned short int>((275 * m) / 9 - (2 - is_leap_year(y)) * ((m + 9) / 12) + d - 30);
+	}
 
-			_seconds = (seconds < 60) ? seconds : (seconds % 100);
+	/* Flat lookup tables for the years 1970 to 2100, both directions are a couple of loads instead of the divisions above.
+	It is about 190 KB so it is only built on the first call to instance(). */
 
-			if (_seconds > 59) _seconds %= 10;
+	class civil_table
+	{
+	public:
+		static ___constexpr___ std::int64_t first_year = 1970;
+		static ___constexpr___ std::int64_t last_year = 2100;
+		static ___constexpr___ std::int64_t size = 47847; /* days from 1970-01-01 to 2100-12-31 inclusive */
 
-			_minutes = (seconds > 59) ? (seconds / 60) : 0;
+		civil_table(const civil_table&) = delete;
+		const civil_table& operator= (const civil_table&) = delete;
 
-			_hours = (_minutes > 59) ? (_minutes / 60) : 0;
+		~civil_table() noexcept = default;
 
-			if (_minutes > 59)
-			{
-				_minutes %= 100;
+		___nodiscard___ static const civil_table& instance()
+		{
+			static const civil_table table;
 
-				if (_minutes > 59) _minutes %= 10;
-			}
+			return table;
 		}
 
-		time(const time& other)
+		___nodiscard___ static ___constexpr___ bool contains(std::int64_t days) noexcept
 		{
-			_hours = other.hours();
-			_minutes = other.minutes();
-			_seconds = other.seconds();
-			_milliseconds = other.milliseconds();
+			return (days >= 0) && (days < size);
 		}
 
-		time(time&& other) noexcept
+		___nodiscard___ static ___constexpr___ bool contains_year(std::int64_t y) noexcept
 		{
-			_hours = std::move(other.hours());
-			_minutes = std::move(other.minutes());
-			_seconds = std::move(other.seconds());
-			_milliseconds = std::move(other.milliseconds());
+			return (y >= first_year) && (y <= last_year);
 		}
 
-		~time() noexcept = default;
-
-		___nodiscard___ unsigned short int hours() const
+		/* The day must be in range, see contains() */
+		___nodiscard___ civil_date to_civil(std::int64_t days) const noexcept
 		{
-			return _hours;
+			const std::uint32_t entry = _entries[days];
+
+			return civil_date{ first_year + (entry >> 21), static_cast<unsigned short int>((entry >> 5) & 0xF), static_cast<unsigned short int>(entry & 0x1F) };
 		}
 
-		___nodiscard___ unsigned short int minutes() const
+		___nodiscard___ unsigned short int weekday(std::int64_t days) const noexcept
 		{
-			return _minutes;
+			return static_cast<unsigned short int>((_entries[days] >> 9) & 0x7);
 		}
 
-		___nodiscard___ unsigned short int seconds() const
+		___nodiscard___ unsigned short int day_of_year(std::int64_t days) const noexcept
 		{
-			return _seconds;
+			return static_cast<unsigned short int>((_entries[days] >> 12) & 0x1FF);
 		}
 
-		___nodiscard___ unsigned short int milliseconds() const
+		/* The year must be in range, see contains_year() */
+		___nodiscard___ std::int64_t to_days(std::int64_t y, unsigned int m, unsigned int d) const noexcept
 		{
-			return _milliseconds;
+			return _year_starts[y - first_year] + _month_starts[is_leap_year(y)][m] + d - 1;
 		}
 
-		___nodiscard___ static time now()
+	private:
+		/* entry bits: 0-4 day, 5-8 month, 9-11 week index, 12-20 day of year, 21-28 year offset */
+		civil_table() noexcept
 		{
-			SYSTEMTIME _systime;
+			for (std::int64_t y = first_year; y <= last_year; ++y)
+				_year_starts[y - first_year] = static_cast<std::int32_t>(days_from_civil(y, 1, 1));
 
-			GetLocalTime(&_systime);
+			for (unsigned int leap = 0; leap < 2; ++leap)
+			{
+				_month_starts[leap][0] = 0;
 
-			return time(_systime.wHour, _systime.wMinute, _systime.wSecond, _systime.wMilliseconds);
-		}
+				for (unsigned int m = 1; m <= 12; ++m)
+					_month_starts[leap][m] = static_cast<std::uint16_t>(dt0::day_of_year(leap ? 2000 : 2001, m, 1) - 1);
+			}
 
-		___nodiscard___ std::string as_string() const
-		{
-			std::string hour = (_hours < 10) ? std::string("0") + std::to_string(_hours) : std::to_string(_hours);
-			std::string minute = (_minutes < 10) ? std::string("0") + std::to_string(_minutes) : std::to_string(_minutes);
-			std::string second = (_seconds < 10) ? std::string("0") + std::to_string(_seconds) : std::to_string(_seconds);
+			for (std::int64_t days = 0; days < size; ++days)
+			{
+				const civil_date C = civil_from_days(days);
 
-			return std::string(hour + std::string(":") + minute + std::string(":") + second + std::string(".") + std::to_string(_milliseconds));
+				_entries[days] = static_cast<std::uint32_t>(C.d)
+					| (static_cast<std::uint32_t>(C.m) << 5)
+					| (static_cast<std::uint32_t>(weekday_from_days(days)) << 9)
+					| (static_cast<std::uint32_t>(dt0::day_of_year(C.y, C.m, C.d)) << 12)
+					| (static_cast<std::uint32_t>(C.y - first_year) << 21);
+			}
 		}
 
-		const time& operator= (const time& other)
-		{
-			_hours = other.hours();
-			_minutes = other.minutes();
-			_seconds = other.seconds();
-			_milliseconds = other.milliseconds();
-
-			return *this;
-		}
+		std::uint32_t _entries[size];
+		std::int32_t _year_starts[last_year - first_year + 1];
+		std::uint16_t _month_starts[2][13];
+	};
 
-		const time& operator= (time&& other) noexcept
-		{
-			_hours = std::move(other.hours());
-			_minutes = std::move(other.minutes());
-			_seconds = std::move(other.seconds());
-			_milliseconds = std::move(other.milliseconds());
+	/* Every clock reading and tick count in this header is in 100 nanosecond ticks since 1970-01-01 00:00:00 */
 
-			return *this;
-		}
+	___constexpr___ std::int64_t ticks_per_millisecond = 10000;
+	___constexpr___ std::int64_t ticks_per_second = 1000 * ticks_per_millisecond;
+	___constexpr___ std::int64_t ticks_per_minute = 60 * ticks_per_second;
+	___constexpr___ std::int64_t ticks_per_hour = 60 * ticks_per_minute;
+	___constexpr___ std::int64_t ticks_per_day = 24 * ticks_per_hour;
 
-	private:
-		unsigned short int _hours;
-		unsigned short int _minutes;
-		unsigned short int _seconds;
-		unsigned short int _milliseconds;
-	};
+	/* Floor division so that instants before 1970 land on the previous day */
+	___nodiscard___ ___constexpr___ std::int64_t days_from_ticks(std::int64_t ticks) noexcept
+	{
+		return (ticks >= 0) ? (ticks / ticks_per_day) : ((ticks + 1) / ticks_per_day - 1);
+	}
 
-	class day
+	/* Whether every instant of the day, give or take a day of UTC offset, fits in ticks, roughly the years -27000 to 31000 */
+	___nodiscard___ ___constexpr14___ bool fits_ticks(std::int64_t y, unsigned int m, unsigned int d) noexcept
 	{
-	public:
-		___constexpr20___ day() noexcept : _name(""), _week_index(0), _month_index(0) {}
+		if ((y < -1000000) || (y > 1000000))
+			return false;
 
-		day(std::string name, unsigned short int week_index, unsigned short int month_index)
-		{
-			if ((week_index > 7) || (week_index < 1))
-				throw basic_error("Invalid week index!");
+		const std::int64_t days = days_from_civil(y, m, d);
 
-			if ((month_index > 31) || (month_index < 1))
-				throw basic_error("Invalid week index!");
+		return (days >= INT64_MIN / ticks_per_day + 2) && (days <= INT64_MAX / ticks_per_day - 2);
+	}
 
-			_name = std::move(name);
-			_week_index = std::move(week_index);
-			_month_index = std::move(month_index);
-		}
+	/* Any std::chrono duration converts to ticks through duration_cast, anything finer than a tick is truncated */
+	using tick_duration = std::chrono::duration<std::int64_t, std::ratio<1, 10000000>>;
 
-		day(unsigned short int week_index, unsigned short int month_index)
-		{
-			if ((week_index > 7) || (week_index < 1))
-				throw basic_error("Invalid week index!");
+	template <class Rep, class Period>
+	___nodiscard___ ___constexpr___ std::int64_t to_ticks(std::chrono::duration<Rep, Period> d) noexcept
+	{
+		return std::chrono::duration_cast<tick_duration>(d).count();
+	}
 
-			if ((month_index > 31) || (month_index < 1))
-				throw basic_error("Invalid week index!");
+	/* Moves by whole calendar months and keeps the time of day. The day of month is clamped to the end of the
+	target month, so January 31 plus one month is February 28 (or 29). */
+	___nodiscard___ ___constexpr14___ std::int64_t add_months_to_ticks(std::int64_t ticks, std::int64_t months) noexcept
+	{
+		const std::int64_t days = days_from_ticks(ticks);
+		const civil_date C = civil_from_days(days);
+		const std::int64_t total = C.y * 12 + (C.m - 1) + months;
+		const std::int64_t y = (total >= 0) ? (total / 12) : ((total + 1) / 12 - 1);
+		const unsigned int m = static_cast<unsigned int>(total - y * 12 + 1);
+		const unsigned int last = days_in_month(y, m);
+
+		return days_from_civil(y, m, (C.d < last) ? C.d : last) * ticks_per_day + (ticks - days * ticks_per_day);
+	}
+
+	/* Whole calendar months from one instant to another, negative when to is earlier, partial months are dropped */
+	___nodiscard___ ___constexpr14___ std::int64_t months_between_ticks(std::int64_t from, std::int64_t to) noexcept
+	{
+		const civil_date A = civil_from_days(days_from_ticks(from));
+		const civil_date B = civil_from_days(days_from_ticks(to));
+		std::int64_t months = (B.y * 12 + B.m) - (A.y * 12 + A.m);
 
-			_week_index = std::move(week_index);
+		if ((months > 0) && (add_months_to_ticks(from, months) > to))
+			--months;
+		else if ((months < 0) && (add_months_to_ticks(from, months) < to))
+			++months;
 
-			_month_index = std::move(month_index);
+		return months;
+	}
 
-			switch (_week_index)
-			{
-			case 1:
-				_name = "Monday";
-				break;
+	___nodiscard___ ___constexpr___ std::int64_t floor_div(std::int64_t a, std::int64_t b) noexcept
+	{
+		return (a / b) - (((a % b) != 0) && ((a < 0) != (b < 0)));
+	}
+
+	enum class time_unit
+	{
+		millisecond,
+		second,
+		minute,
+		hour,
+		day,
+		week,		/* ISO weeks, starting on Monday */
+		month,
+		quarter,
+		year
+	};
 
-			case 2:
-				_name = "Tuesday";
-				break;
+	/* Whole units since 1970-01-01 00:00:00, week 0 starts on Monday 1969-12-29 */
+	___nodiscard___ ___constexpr14___ std::int64_t bucket_of(std::int64_t ticks, time_unit unit) noexcept
+	{
+		switch (unit)
+		{
+		case time_unit::millisecond:
+			return floor_div(ticks, ticks_per_millisecond);
 
-			case 3:
-				_name = "Wednesday";
-				break;
+		case time_unit::second:
+			return floor_div(ticks, ticks_per_second);
 
-			case 4:
-				_name = "Thursday";
-				break;
+		case time_unit::minute:
+			return floor_div(ticks, ticks_per_minute);
 
-			case 5:
-				_name = "Friday";
-				break;
+		case time_unit::hour:
+			return floor_div(ticks, ticks_per_hour);
 
-			case 6:
-				_name = "Saturday";
-				break;
+		case time_unit::day:
+			return days_from_ticks(ticks);
 
-			case 7:
-				_name = "Sunday";
-				break;
+		case time_unit::week:
+			return floor_div(days_from_ticks(ticks) + 3, 7);
 
-			default:
-				throw basic_error("Invalid week index!");
-				break;
-			}
+		default:
+			break;
 		}
 
-		day(std::string name)
-		{
-			_month_index = 0;
+		const civil_date C = civil_from_days(days_from_ticks(ticks));
+		const std::int64_t months = (C.y - 1970) * 12 + C.m - 1;
 
-			if ((name == "Monday") || (name == "monday") || (name == "Mon") || (name == "mon") || (name == "M"))
-			{
-				_week_index = 1;
-			}
+		if (unit == time_unit::month)
+			return months;
 
-			else if ((name == "Tuesday") || (name == "Tue") || (name == "Tues") ||
-				(name == "tue") || (name == "tues") || (name == "T") || (name == "Tu"))
-			{
-				_week_index = 2;
-			}
+		return (unit == time_unit::quarter) ? floor_div(months, 3) : (C.y - 1970);
+	}
 
-			else if ((name == "Wednesday") || (name == "wednesday") || (name == "Wed") || (name == "wed") || (name == "W"))
-			{
-				_week_index = 3;
-			}
+	/* The first tick of a bucket returned by bucket_of */
+	___nodiscard___ ___constexpr14___ std::int64_t bucket_start(std::int64_t bucket, time_unit unit) noexcept
+	{
+		switch (unit)
+		{
+		case time_unit::millisecond:
+			return bucket * ticks_per_millisecond;
 
-			else if ((name == "Thursday") || (name == "thursday") || (name == "Thu") || (name == "Thur") ||
-				(name == "Thurs") || (name == "thu") || (name == "thur") ||
-				(name == "thurs") || (name == "Th") || (name == "R"))
-			{
-				_week_index = 4;
-			}
+		case time_unit::second:
+			return bucket * ticks_per_second;
 
-			else if ((name == "Friday") || (name == "friday") || (name == "Fri") || (name == "fri") || (name == "F"))
-			{
-				_week_index = 5;
-			}
+		case time_unit::minute:
+			return bucket * ticks_per_minute;
 
-			else if ((name == "Saturday") || (name == "saturday") || (name == "Sat") || (name == "sat") || (name == "Sa") || (name == "S"))
-			{
-				_week_index = 6;
-			}
+		case time_unit::hour:
+			return bucket * ticks_per_hour;
 
-			else if ((name == "Sunday") || (name == "sunday") || (name == "Sun") || (name == "sun") || (name == "Su") || (name == "S") || (name == "U"))
-			{
-				_week_index = 7;
-			}
+		case time_unit::day:
+			return bucket * ticks_per_day;
 
-			else throw basic_error("Invalid name!");
+		case time_unit::week:
+			return (bucket * 7 - 3) * ticks_per_day;
 
-			_name = std::move(name);
+		default:
+			break;
 		}
 
-		day(const day& other)
-		{
-			_name = other.name();
-			_week_index = other.week_index();
-			_month_index = other.month_index();
-		}
+		const std::int64_t months = (unit == time_unit::month) ? bucket : ((unit == time_unit::quarter) ? (bucket * 3) : (bucket * 12));
+		const std::int64_t y = 1970 + floor_div(months, 12);
 
-		day(day&& other) noexcept
-		{
-			_name = std::move(other.name());
-			_week_index = std::move(other.week_index());
-			_month_index = std::move(other.month_index());
-		}
+		return days_from_civil(y, static_cast<unsigned int>(months - (y - 1970) * 12 + 1), 1) * ticks_per_day;
+	}
 
-		~day() noexcept = default;
+	___nodiscard___ ___constexpr14___ std::int64_t floor_ticks(std::int64_t ticks, time_unit unit) noexcept
+	{
+		return bucket_start(bucket_of(ticks, unit), unit);
+	}
 
-		___nodiscard___ std::string name() const
-		{
-			return _name;
-		}
+	___nodiscard___ ___constexpr14___ std::int64_t ceil_ticks(std::int64_t ticks, time_unit unit) noexcept
+	{
+		const std::int64_t bucket = bucket_of(ticks, unit);
+		const std::int64_t start = bucket_start(bucket, unit);
 
-		___nodiscard___ unsigned short int week_index() const
-		{
-			return _week_index;
-		}
+		return (start == ticks) ? start : bucket_start(bucket + 1, unit);
+	}
 
-		___nodiscard___ unsigned short int month_index() const
-		{
-			return _month_index;
-		}
+	/* Fixed width windows of width ticks aligned on origin, such as 15 minute windows or 7 day windows starting on a Sunday */
+	___nodiscard___ ___constexpr___ std::int64_t bucket_of(std::int64_t ticks, std::int64_t width, std::int64_t origin = 0) noexcept
+	{
+		return floor_div(ticks - origin, width);
+	}
 
-		const day& operator= (const day& other)
-		{
-			_name = other.name();
-			_week_index = other.week_index();
-			_month_index = other.month_index();
+	___nodiscard___ ___constexpr___ std::int64_t floor_ticks(std::int64_t ticks, std::int64_t width, std::int64_t origin = 0) noexcept
+	{
+		return bucket_of(ticks, width, origin) * width + origin;
+	}
 
-			return *this;
-		}
+	___nodiscard___ ___constexpr14___ std::int64_t ceil_ticks(std::int64_t ticks, std::int64_t width, std::int64_t origin = 0) noexcept
+	{
+		const std::int64_t start = floor_ticks(ticks, width, origin);
 
-		const day& operator= (day&& other) noexcept
-		{
-			_name = std::move(other.name());
-			_week_index = std::move(other.week_index());
-			_month_index = std::move(other.month_index());
+		return (start == ticks) ? start : (start + width);
+	}
 
-			return *this;
-		}
+	enum class clock_source
+	{
+		realtime,			/* CLOCK_REALTIME, GetSystemTimePreciseAsFileTime on Windows */
+		realtime_coarse,	/* CLOCK_REALTIME_COARSE, served from the vDSO at tick resolution, GetSystemTimeAsFileTime on Windows */
+		monotonic			/* CLOCK_MONOTONIC anchored to the wall clock on first use, never jumps with clock adjustments */
+	};
+
+	/* Reads the current UTC time from the selected clock */
+	___nodiscard___ inline std::int64_t utc_ticks(clock_source source = clock_source::realtime) noexcept
+	{
+#ifdef _WIN32
+		/* FILETIME counts 100 nanosecond ticks since 1601-01-01 */
+		const std::int64_t filetime_epoch = 116444736000000000LL;
 
-		const day& operator= (std::pair<unsigned short int, unsigned short int> day_indexes)
+		if (source == clock_source::monotonic)
 		{
-			if ((day_indexes.first > 7) || (day_indexes.first < 1))
-				throw basic_error("Invalid week index!");
+			static const LARGE_INTEGER frequency = []() { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return f; }();
+			static const LARGE_INTEGER start = []() { LARGE_INTEGER c; QueryPerformanceCounter(&c); return c; }();
+			static const std::int64_t anchor = utc_ticks(clock_source::realtime);
 
-			if ((day_indexes.second > 31) || (day_indexes.second < 1))
-				throw basic_error("Invalid week index!");
+			LARGE_INTEGER counter;
+			QueryPerformanceCounter(&counter);
 
-			_week_index = std::move(day_indexes.first);
+			const std::int64_t elapsed = counter.QuadPart - start.QuadPart;
 
-			_month_index = std::move(day_indexes.second);
+			return anchor + (elapsed / frequency.QuadPart) * ticks_per_second + ((elapsed % frequency.QuadPart) * ticks_per_second) / frequency.QuadPart;
+		}
 
-			switch (_week_index)
-			{
-			case 1:
-				_name = "Monday";
-				break;
+		FILETIME _filetime;
 
-			case 2:
-				_name = "Tuesday";
-				break;
+		if (source == clock_source::realtime_coarse)
+			GetSystemTimeAsFileTime(&_filetime);
+		else
+			GetSystemTimePreciseAsFileTime(&_filetime);
 
-			case 3:
-				_name = "Wednesday";
-				break;
+		return ((static_cast<std::int64_t>(_filetime.dwHighDateTime) << 32) | _filetime.dwLowDateTime) - filetime_epoch;
+#else
+		timespec _timespec;
 
-			case 4:
-				_name = "Thursday";
-				break;
+		switch (source)
+		{
+		case clock_source::realtime_coarse:
+#ifdef CLOCK_REALTIME_COARSE
+			clock_gettime(CLOCK_REALTIME_COARSE, &_timespec);
+#else
+			clock_gettime(CLOCK_REALTIME, &_timespec);
+#endif
+			break;
 
-			case 5:
-				_name = "Friday";
-				break;
+		case clock_source::monotonic:
+		{
+			static const std::int64_t anchor = []() noexcept
+			{
+				timespec _real, _mono;
 
-			case 6:
-				_name = "Saturday";
-				break;
+				clock_gettime(CLOCK_REALTIME, &_real);
+				clock_gettime(CLOCK_MONOTONIC, &_mono);
 
-			case 7:
-				_name = "Sunday";
-				break;
+				return (static_cast<std::int64_t>(_real.tv_sec) - _mono.tv_sec) * ticks_per_second + (static_cast<std::int64_t>(_real.tv_nsec) - _mono.tv_nsec) / 100;
+			}();
 
-			default:
-				throw basic_error("Invalid week index!");
-				break;
-			}
+			clock_gettime(CLOCK_MONOTONIC, &_timespec);
 
-			return *this;
+			return anchor + static_cast<std::int64_t>(_timespec.tv_sec) * ticks_per_second + _timespec.tv_nsec / 100;
 		}
 
-		const day& operator= (std::string name)
-		{
-			_month_index = 0;
-
-			if ((name == "Monday") || (name == "monday") || (name == "Mon") || (name == "mon") || (name == "M"))
-			{
-				_week_index = 1;
-			}
-
-			else if ((name == "Tuesday") || (name == "Tue") || (name == "Tues") ||
-				(name == "tue") || (name == "tues") || (name == "T") || (name == "Tu"))
-			{
-				_week_index = 2;
-			}
+		default:
+			clock_gettime(CLOCK_REALTIME, &_timespec);
+			break;
+		}
 
-			else if ((name == "Wednesday") || (name == "wednesday") || (name == "Wed") || (name == "wed") || (name == "W"))
-			{
-				_week_index = 3;
-			}
+		return static_cast<std::int64_t>(_timespec.tv_sec) * ticks_per_second + _timespec.tv_nsec / 100;
+#endif
+	}
 
-			else if ((name == "Thursday") || (name == "thursday") || (name == "Thu") || (name == "Thur") ||
-				(name == "Thurs") || (name == "thu") || (name == "thur") ||
-				(name == "thurs") || (name == "Th") || (name == "R"))
-			{
-				_week_index = 4;
-			}
+	/* Offset of the machine's local time zone from UTC at the given UTC instant */
+	___nodiscard___ inline std::int64_t local_offset_ticks(std::int64_t utc) noexcept
+	{
+#ifdef _WIN32
+		const std::int64_t filetime_epoch = 116444736000000000LL;
+		const std::int64_t _utc = utc + filetime_epoch;
 
-			else if ((name == "Friday") || (name == "friday") || (name == "Fri") || (name == "fri") || (name == "F"))
-			{
-				_week_index = 5;
-			}
+		FILETIME _filetime, _local;
 
-			else if ((name == "Saturday") || (name == "saturday") || (name == "Sat") || (name == "sat") || (name == "Sa") || (name == "S"))
-			{
-				_week_index = 6;
-			}
+		_filetime.dwLowDateTime = static_cast<DWORD>(_utc & 0xFFFFFFFF);
+		_filetime.dwHighDateTime = static_cast<DWORD>(_utc >> 32);
 
-			else if ((name == "Sunday") || (name == "sunday") || (name == "Sun") || (name == "sun") || (name == "Su") || (name == "S") || (name == "U"))
-			{
-				_week_index = 7;
-			}
+		if (!FileTimeToLocalFileTime(&_filetime, &_local))
+			return 0;
 
-			else throw basic_error("Invalid name!");
+		return ((static_cast<std::int64_t>(_local.dwHighDateTime) << 32) | _local.dwLowDateTime) - _utc;
+#else
+		const time_t _seconds = static_cast<time_t>((utc >= 0) ? (utc / ticks_per_second) : ((utc + 1) / ticks_per_second - 1));
 
-			_name = std::move(name);
+		tm _local;
 
-			return *this;
-		}
+		if (localtime_r(&_seconds, &_local) == nullptr)
+			return 0;
 
-		___nodiscard___ static day now()
-		{
-			SYSTEMTIME _sysinfo;
+		return static_cast<std::int64_t>(_local.tm_gmtoff) * ticks_per_second;
+#endif
+	}
 
-			GetLocalTime(&_sysinfo);
+	/* Reads the current local wall clock time from the selected clock */
+	___nodiscard___ inline std::int64_t local_ticks(clock_source source = clock_source::realtime) noexcept
+	{
+		const std::int64_t utc = utc_ticks(source);
 
-			return day(_sysinfo.wDayOfWeek, _sysinfo.wDay);
-		}
+		return utc + local_offset_ticks(utc);
+	}
 
-	private:
-		std::string _name;
-		unsigned short int _week_index;
-		unsigned short int _month_index;
-	};
+	/* Building blocks for the to_chars functions below, they write into buffers that are known to be large enough */
 
-	class month
+	namespace detail
 	{
-	public:
-		___constexpr20___ month() noexcept : _index(0), _name(""), _days(0) 
-		{}
+		inline ___constexpr___ char digit_pairs[] =
+			"0001020304050607080910111213141516171819"
+			"2021222324252627282930313233343536373839"
+			"4041424344454647484950515253545556575859"
+			"6061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		inline ___constexpr___ std::uint32_t powers_of_ten[] = { 1, 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
 
-		month(unsigned short int index, std::string name, unsigned short int days)
+		inline char* write_2digits(char* p, unsigned int value) noexcept
 		{
-			if ((index > 12) || (index < 1))
-				throw basic_error("Invalid month index!");
+			std::memcpy(p, digit_pairs + 2 * value, 2);
 
-			if (((index < 8) && (index % 2 == 1)) || ((index > 7) && (index % 2 == 0)))
-			{
-				if (days != 31) throw basic_error("Invalid ammount of days for month!");
-			}
+			return p + 2;
+		}
 
-			else if (((index < 8) && (index % 2 == 0) && (index != 2)) || ((index > 7) && (index % 2 == 1)))
-			{
-				if (days != 30) throw basic_error("Invalid ammount of days for month!");
-			}
+		/* Writes exactly digits characters, value must fit */
+		inline char* write_fixed(char* p, std::uint32_t value, unsigned int digits) noexcept
+		{
+			char* q = p + digits;
 
-			else
+			while (q - p > 1)
 			{
-				if ((days != 28) || (days != 29)) throw basic_error("Invalid ammount of days for month!");
+				q -= 2;
+				std::memcpy(q, digit_pairs + 2 * (value % 100), 2);
+				value /= 100;
 			}
 
-			_index = std::move(index);
-			_name = std::move(name);
-			_days = std::move(days);
+			if (q != p)
+				*p = static_cast<char>('0' + value);
+
+			return p + digits;
 		}
 
-		month(std::string name, unsigned short int index, unsigned short int days)
+		/* Writes at least min_digits characters, padded with zeroes */
+		inline char* write_unsigned(char* p, std::uint64_t value, unsigned int min_digits) noexcept
 		{
-			if ((index > 12) || (index < 1))
-				throw basic_error("Invalid month index!");
+			char _buffer[20];
+			char* const end = _buffer + 20;
+			char* q = end;
 
-			if (((index < 8) && (index % 2 == 1)) || ((index > 7) && (index % 2 == 0)))
+			while (value >= 100)
 			{
-				if (days != 31) throw basic_error("Invalid ammount of days for month!");
+				q -= 2;
+				std::memcpy(q, digit_pairs + 2 * (value % 100), 2);
+				value /= 100;
 			}
 
-			else if (((index < 8) && (index % 2 == 0) && (index != 2)) || ((index > 7) && (index % 2 == 1)))
+			if (value >= 10)
 			{
-				if (days != 30) throw basic_error("Invalid ammount of days for month!");
-			}
-			
-			else
-			{
-				if((days != 28) || (days != 29)) throw basic_error("Invalid ammount of days for month!");
+				q -= 2;
+				std::memcpy(q, digit_pairs + 2 * value, 2);
 			}
 
-			_name = std::move(name);
-			_index = std::move(index);
-			_days = std::move(days);
+			else *--q = static_cast<char>('0' + value);
+
+			while (end - q < static_cast<std::ptrdiff_t>(min_digits))
+				*--q = '0';
+
+			std::memcpy(p, q, static_cast<std::size_t>(end - q));
+
+			return p + (end - q);
 		}
 
-		month(unsigned short int index)
+		/* ISO 8601 years, four digits from 0000 to 9999 and a sign with at least four digits outside of that */
+		inline char* write_year(char* p, std::int64_t y) noexcept
 		{
-			if ((index > 12) || (index < 1))
-				throw basic_error("Invalid month index!");
+			if ((y >= 0) && (y <= 9999))
+				return write_2digits(write_2digits(p, static_cast<unsigned int>(y / 100)), static_cast<unsigned int>(y % 100));
 
-			_index = std::move(index);
+			*p++ = (y < 0) ? '-' : '+';
 
-			switch (_index)
-			{
-			case 1:
-				_name = "January";
-				_days = 31;
-				break;
-
-			case 2:
-				_name = "Februrary";
-				_days = 28;
-				break;
-
-			case 3:
-				_name = "March";
-				_days = 31;
-				break;
-
-			case 4:
-				_name = "April";
-				_days = 30;
-				break;
-
-			case 5:
-				_name = "May";
-				_days = 31;
-				break;
-
-			case 6:
-				_name = "June";
-				_days = 30;
-				break;
-
-			case 7:
-				_name = "July";
-				_days = 31;
-				break;
-
-			case 8:
-				_name = "August";
-				_days = 31;
-				break;
-
-			case 9:
-				_name = "September";
-				_days = 30;
-				break;
-
-			case 10:
-				_name = "October";
-				_days = 31;
-				break;
-
-			case 11:
-				_name = "November";
-				_days = 30;
-				break;
-
-			case 12:
-				_name = "December";
-				_days = 31;
-				break;
-			}
+			return write_unsigned(p, (y < 0) ? (0 - static_cast<std::uint64_t>(y)) : static_cast<std::uint64_t>(y), 4);
 		}
 
-		month(std::string name)
+		/* YYYY-MM-DD */
+		inline char* write_date(char* p, std::int64_t y, unsigned int m, unsigned int d) noexcept
 		{
-			if ((name == "January") || (name == "january") || (name == "Jan") || (name == "jan"))
-			{
-				_index = 1;
-				_days = 31;
-			}
+			p = write_year(p, y);
+			*p++ = '-';
+			p = write_2digits(p, m);
+			*p++ = '-';
 
-			else if ((name == "February") || (name == "february") || (name == "Feb") || (name == "feb"))
-			{
-				_index = 2;
-				_days = 28;
-			}
+			return write_2digits(p, d);
+		}
 
-			else if ((name == "March") || (name == "march") || (name == "Mar") || (name == "mar"))
-			{
-				_index = 3;
-				_days = 31;
-			}
+		/* HH:MM:SS followed by a dot and fraction_digits digits of fraction unless fraction_digits is 0 */
+		inline char* write_time(char* p, unsigned int h, unsigned int mi, unsigned int s, std::uint32_t fraction, unsigned int fraction_digits) noexcept
+		{
+			p = (h < 100) ? write_2digits(p, h) : write_unsigned(p, h, 2);
+			*p++ = ':';
+			p = write_2digits(p, mi);
+			*p++ = ':';
+			p = write_2digits(p, s);
 
-			else if ((name == "April") || (name == "april") || (name == "Apr") || (name == "apr"))
-			{
-				_index = 4; _days = 30;
-			}
+			if (fraction_digits == 0)
+				return p;
 
-			else if ((name == "May") || (name == "may"))
-			{
-				_index = 5; _days = 31;
-			}
+			*p++ = '.';
 
-			else if ((name == "June") || (name == "june") || (name == "Jun") || (name == "jun"))
-			{
-				_index = 6;
-				_days = 30;
-			}
+			return write_fixed(p, fraction, fraction_digits);
+		}
 
-			else if ((name == "July") || (name == "july") || (name == "Jul") || (name == "jul"))
-			{
-				_index = 7;
-				_days = 31;
-			}
+		/* Writers go straight into the caller's buffer when it can hold the longest output and into a scratch buffer otherwise */
+		inline std::to_chars_result finish_chars(char* first, char* last, const char* scratch, const char* end) noexcept
+		{
+			const std::ptrdiff_t size = end - scratch;
 
-			else if ((name == "August") || (name == "august") || (name == "Aug") || (name == "aug"))
-			{
-				_index = 8;
-				_days = 31;
-			}
+			if (size > last - first)
+				return std::to_chars_result{ last, std::errc::value_too_large };
 
-			else if ((name == "September") || (name == "september") || (name == "Sep") || (name == "sep"))
-			{
-				_index = 9;
-				_days = 30;
-			}
+			std::memcpy(first, scratch, static_cast<std::size_t>(size));
 
-			else if ((name == "October") || (name == "october") || (name == "Oct") || (name == "oct"))
-			{
-				_index = 10;
-				_days = 31;
-			}
+			return std::to_chars_result{ first + size, std::errc() };
+		}
+	}
 
-			else if ((name == "November") || (name == "november") || (name == "Nov") || (name == "nov"))
-			{
-				_index = 11;
-				_days = 30;
-			}
-
-			else if ((name == "December") || (name == "december") || (name == "Dec") || (name == "dec"))
-			{
-				_index = 12;
-				_days = 31;
-			}
-
-			else throw basic_error("Invalid month name!");
-
-			_name = std::move(name);
-		}
-
-		month(const month& other)
-		{
-			_index = other.index();
-			_name = other.name();
-			_days = other.days();
-		}
-
-		month(month&& other) noexcept
-		{
-			_index = std::move(other.index());
-			_name = std::move(other.name());
-			_days = std::move(other.days());
-		}
-
-		~month() noexcept = default;
+	class time
+	{
+	public:
+		static ___constexpr___ std::ptrdiff_t max_chars = 16;
 
-		___nodiscard___ unsigned short int index() const
-		{
-			return _index;
-		}
+		___constexpr20___ time() noexcept : _hours(0), _minutes(0), _seconds(0), _milliseconds(0) {}
 
-		___nodiscard___ std::string name() const
+		___constexpr20___ time(unsigned short int hours, unsigned short int minutes, unsigned short int seconds, unsigned short int milliseconds)
 		{
-			return _name;
-		}
+			if (milliseconds > 999)
+				throw basic_error("Invalid value for milliseconds!");
 
-		___nodiscard___ unsigned short int days() const
-		{
-			return _days;
-		}
+			if (seconds > 59)
+				throw basic_error("Invalid value for seconds!");
 
-		const month& operator= (const month& other)
-		{
-			_index = other.index();
-			_name = other.name();
-			_days = other.days();
+			if (minutes > 59)
+				throw basic_error("Invalid value for minutes!");
 
-			return *this;
+			_hours = std::move(hours);
+			_minutes = std::move(minutes);
+			_seconds = std::move(seconds);
+			_milliseconds = std::move(milliseconds);
 		}
 
-		const month& operator= (month&& other) noexcept
+		time(unsigned int milliseconds)
 		{
-			_index = std::move(other.index());
-			_name = std::move(other.name());
-			_days = std::move(other.days());
-
-			return *this;
-		}
+			_milliseconds = (milliseconds < 1000) ? milliseconds : (milliseconds % 1000);
 
-		const month& operator= (unsigned short int index)
-		{
-			if ((index > 12) || (index < 1))
-				throw basic_error("Invalid month index!");
+			_seconds = (milliseconds > 999) ? (milliseconds / 1000) : 0;
 
-			_index = std::move(index);
+			_minutes = (_seconds > 59) ? (_seconds / 60) : 0;
 
-			switch (_index)
+			if (_seconds > 59)
 			{
-			case 1:
-				_name = "January";
-				_days = 31;
-				break;
-
-			case 2:
-				_name = "Februrary";
-				_days = 28;
-				break;
-
-			case 3:
-				_name = "March";
-				_days = 31;
-				break;
-
-			case 4:
-				_name = "April";
-				_days = 30;
-				break;
-
-			case 5:
-				_name = "May";
-				_days = 31;
-				break;
-
-			case 6:
-				_name = "June";
-				_days = 30;
-				break;
-
-			case 7:
-				_name = "July";
-				_days = 31;
-				break;
-
-			case 8:
-				_name = "August";
-				_days = 31;
-				break;
-
-			case 9:
-				_name = "September";
-				_days = 30;
-				break;
-
-			case 10:
-				_name = "October";
-				_days = 31;
-				break;
-
-			case 11:
-				_name = "November";
-				_days = 30;
-				break;
-
-			case 12:
-				_name = "December";
-				_days = 31;
-				break;
-			}
-
-			return *this;
-		}
+				_seconds %= 100;
 
-		const month& operator= (std::string name)
-		{
-			if ((name == "January") || (name == "january") || (name == "Jan") || (name == "jan"))
-			{
-				_index = 1;
-				_days = 31;
+				if (_seconds > 59) _seconds %= 10;
 			}
 
-			else if ((name == "February") || (name == "february") || (name == "Feb") || (name == "feb"))
-			{
-				_index = 2;
-				_days = 28;
-			}
+			_hours = (_minutes > 59) ? (_minutes / 60) : 0;
 
-			else if ((name == "March") || (name == "march") || (name == "Mar") || (name == "mar"))
+			if (_minutes > 59)
 			{
-				_index = 3;
-				_days = 31;
-			}
+				_minutes %= 100;
 
-			else if ((name == "April") || (name == "april") || (name == "Apr") || (name == "apr"))
-			{
-				_index = 4; _days = 30;
+				if (_minutes > 59) _minutes %= 10;
 			}
+		}
 
-			else if ((name == "May") || (name == "may"))
-			{
-				_index = 5; _days = 31;
-			}
+		time(unsigned short int seconds)
+		{
+			_milliseconds = 0;
 
-			else if ((name == "June") || (name == "june") || (name == "Jun") || (name == "jun"))
-			{
-				_index = 6;
-				_days = 30;
-			}
+			_seconds = (seconds < 60) ? seconds : (seconds % 100);
 
-			else if ((name == "July") || (name == "july") || (name == "Jul") || (name == "jul"))
-			{
-				_index = 7;
-				_days = 31;
-			}
+			if (_seconds > 59) _seconds %= 10;
 
-			else if ((name == "August") || (name == "august") || (name == "Aug") || (name == "aug"))
-			{
-				_index = 8;
-				_days = 31;
-			}
+			_minutes = (seconds > 59) ? (seconds / 60) : 0;
 
-			else if ((name == "September") || (name == "september") || (name == "Sep") || (name == "sep"))
-			{
-				_index = 9;
-				_days = 30;
-			}
+			_hours = (_minutes > 59) ? (_minutes / 60) : 0;
 
-			else if ((name == "October") || (name == "october") || (name == "Oct") || (name == "oct"))
+			if (_minutes > 59)
 			{
-				_index = 10;
-				_days = 31;
-			}
+				_minutes %= 100;
 
-			else if ((name == "November") || (name == "november") || (name == "Nov") || (name == "nov"))
-			{
-				_index = 11;
-				_days = 30;
+				if (_minutes > 59) _minutes %= 10;
 			}
+		}
 
-			else if ((name == "December") || (name == "december") || (name == "Dec") || (name == "dec"))
-			{
-				_index = 12;
-				_days = 31;
-			}
+		time(const time& other) noexcept = default;
+		time(time&& other) noexcept = default;
 
-			else throw basic_error("Invalid month name!");
+		~time() noexcept = default;
 
-			_name = std::move(name);
+		___nodiscard___ ___constexpr___ unsigned short int hours() const
+		{
+			return _hours;
+		}
 
-			return *this;
+		___nodiscard___ ___constexpr___ unsigned short int minutes() const
+		{
+			return _minutes;
 		}
 
-		___nodiscard___ static month now()
+		___nodiscard___ ___constexpr___ unsigned short int seconds() const
 		{
-			SYSTEMTIME _sysinfo;
+			return _seconds;
+		}
 
-			GetLocalTime(&_sysinfo);
+		___nodiscard___ ___constexpr___ unsigned short int milliseconds() const
+		{
+			return _milliseconds;
+		}
 
-			return month(_sysinfo.wMonth);
+		___nodiscard___ static time now(clock_source source = clock_source::realtime)
+		{
+			return from_ticks(local_ticks(source));
 		}
 
-		___nodiscard___ bool operator== (const month& other) const
+		/* Time of day of a tick count, whole days are dropped */
+		___nodiscard___ static time from_ticks(std::int64_t ticks)
 		{
-			if ((_index == other.index()) && (_name == other.name()) && (_days == other.days()))
-				return true;
+			const std::int64_t tod = ticks - days_from_ticks(ticks) * ticks_per_day;
 
-			return false;
+			return time(static_cast<unsigned short int>(tod / ticks_per_hour),
+				static_cast<unsigned short int>((tod / ticks_per_minute) % 60),
+				static_cast<unsigned short int>((tod / ticks_per_second) % 60),
+				static_cast<unsigned short int>((tod / ticks_per_millisecond) % 1000));
 		}
 
-		___nodiscard___ bool operator== (const std::string& other) const
+		___nodiscard___ std::string as_string() const
 		{
-			if (_name == other)
-				return true;
+			char _buffer[max_chars];
 
-			return false;
+			return std::string(_buffer, to_chars(_buffer, _buffer + max_chars).ptr);
 		}
 
-		___nodiscard___ bool operator== (const unsigned short int& other) const
+		/* HH:MM:SS.mmm, nothing is allocated */
+		std::to_chars_result to_chars(char* first, char* last) const noexcept
 		{
-			if (_index == other)
-				return true;
+			char _scratch[max_chars];
+			char* const out = ((last - first) >= max_chars) ? first : _scratch;
+			char* const end = detail::write_time(out, _hours, _minutes, _seconds, _milliseconds, 3);
 
-			return false;
+			return (out == first) ? std::to_chars_result{ end, std::errc() } : detail::finish_chars(first, last, _scratch, end);
 		}
 
-	private:
-		unsigned short int _index;
-		std::string _name;
-		unsigned short int _days;
-	};
-
-	class year
-	{
-	public:
-		___constexpr20___ year() noexcept : _value(0), _leap_year(false), _bce(false) {}
+		time& operator= (const time& other) noexcept = default;
+		time& operator= (time&& other) noexcept = default;
 
-		year(unsigned __int64 value, bool leap_year, bool bce)
+		/* Packs the fields so that comparing keys compares times */
+		___nodiscard___ ___constexpr___ std::uint64_t order_key() const noexcept
 		{
-			if (((value % 4) != 0) && (leap_year == true))
-				throw basic_error("Year is not a leap year!");
-
-			_value = std::move(value);
-			_leap_year = std::move(leap_year);
-			_bce = std::move(bce);
+			return (static_cast<std::uint64_t>(_hours) << 48) | (static_cast<std::uint64_t>(_minutes) << 32) | (static_cast<std::uint64_t>(_seconds) << 16) | _milliseconds;
 		}
 
-		year(unsigned __int64 value, bool bce)
+		___nodiscard___ ___constexpr___ bool operator== (const time& other) const noexcept
 		{
-			_value = std::move(value);
-			_leap_year = ((_value % 4) == 0) ? true : false;
-			_bce = std::move(bce);
+			return order_key() == other.order_key();
 		}
 
-		year(unsigned __int64 value)
+		___nodiscard___ ___constexpr___ bool operator!= (const time& other) const noexcept
 		{
-			_value = std::move(value);
-			_leap_year = ((_value % 4) == 0) ? true : false;
-			_bce = false;
+			return order_key() != other.order_key();
 		}
 
-		year(const year& other)
+		___nodiscard___ ___constexpr___ bool operator< (const time& other) const noexcept
 		{
-			_value = other.value();
-			_leap_year = other.leap_year();
-			_bce = other.bce();
+			return order_key() < other.order_key();
 		}
 
-		year(year&& other) noexcept
+		___nodiscard___ ___constexpr___ bool operator<= (const time& other) const noexcept
 		{
-			_value = std::move(other.value());
-			_leap_year = std::move(other.leap_year());
-			_bce = std::move(other.bce());
+			return order_key() <= other.order_key();
 		}
 
-		~year() noexcept = default;
-
-		___nodiscard___ unsigned __int64 value() const
+		___nodiscard___ ___constexpr___ bool operator> (const time& other) const noexcept
 		{
-			return _value;
+			return order_key() > other.order_key();
 		}
 
-		___nodiscard___ bool leap_year() const
+		___nodiscard___ ___constexpr___ bool operator>= (const time& other) const noexcept
 		{
-			return _leap_year;
+			return order_key() >= other.order_key();
 		}
 
-		___nodiscard___ bool bce() const
+#if ___cpp20___
+		___nodiscard___ ___constexpr___ std::strong_ordering operator<=> (const time& other) const noexcept
 		{
-			return _bce;
+			return order_key() <=> other.order_key();
 		}
+#endif
+
+	private:
+		unsigned short int _hours;
+		unsigned short int _minutes;
+		unsigned short int _seconds;
+		unsigned short int _milliseconds;
+	};
+
+	/* A signed count of Period units, 100 nanosecond ticks unless another resolution is chosen. It is a std::chrono::duration
+	underneath with nothing added to its layout, so it is handed to chrono code and to every dt0 function taking a chrono duration
+	as it is. Chrono durations that convert without loss (any other dt0 duration included) convert to it implicitly, lossy ones
+	go through std::chrono::duration_cast, floor, ceil or round first. The arithmetic is chrono's and returns chrono durations,
+	which convert back the same way. Unlike time it does not wrap at midnight and it can be negative. */
+	template <class Period = tick_duration::period>
+	class duration : public std::chrono::duration<std::int64_t, Period>
+	{
+	public:
+		using base = std::chrono::duration<std::int64_t, Period>;
+
+		static ___constexpr___ std::ptrdiff_t max_chars = 32;
+
+		___constexpr___ duration() noexcept : base(0) {}
+
+		explicit ___constexpr___ duration(std::int64_t count) noexcept : base(count) {}
+
+		template <class Rep2, class Period2, class = std::enable_if_t<std::is_convertible<std::chrono::duration<Rep2, Period2>, base>::value>>
+		___constexpr___ duration(const std::chrono::duration<Rep2, Period2>& other) noexcept : base(other) {}
+
+		duration(const duration& other) noexcept = default;
+		duration(duration&& other) noexcept = default;
+
+		~duration() noexcept = default;
 
-		const year& operator= (const year& other)
+		duration& operator= (const duration& other) noexcept = default;
+		duration& operator= (duration&& other) noexcept = default;
+
+		/* Truncated toward zero for resolutions finer than a tick */
+		___nodiscard___ ___constexpr___ std::int64_t ticks() const noexcept
 		{
-			_value = other.value();
-			_leap_year = other.leap_year();
-			_bce = other.bce();
+			return to_ticks(static_cast<const base&>(*this));
+		}
 
-			return *this;
+		/* The time of day part, whole days are dropped the way time::from_ticks drops them */
+		___nodiscard___ time to_time() const
+		{
+			return time::from_ticks(ticks());
 		}
 
-		const year& operator= (year&& other) noexcept
+		/* Exact for resolutions of a millisecond or finer, truncated for coarser ones */
+		___nodiscard___ static ___constexpr20___ duration from_time(const time& value) noexcept
 		{
-			_value = std::move(other.value());
-			_leap_year = std::move(other.leap_year());
-			_bce = std::move(other.bce());
+			const std::chrono::milliseconds _milliseconds(((static_cast<std::int64_t>(value.hours()) * 60 + value.minutes()) * 60 + value.seconds()) * 1000 + value.milliseconds());
 
-			return *this;
+			return duration(std::chrono::duration_cast<base>(_milliseconds));
 		}
 
-		const year& operator= (unsigned __int64 other)
+		___nodiscard___ std::string as_string() const
 		{
-			_value = std::move(other);
-			_leap_year = ((_value % 4) == 0) ? true : false;
-			_bce = false;
+			char _buffer[max_chars];
 
-			return *this;
+			return std::string(_buffer, to_chars(_buffer, _buffer + max_chars).ptr);
 		}
 
-		___nodiscard___ static year now()
+		/* [-][D.]HH:MM:SS[.fffffff] to the tick, the days and the fraction only when they are not 0, nothing is allocated */
+		std::to_chars_result to_chars(char* first, char* last) const noexcept
 		{
-			SYSTEMTIME _sysinfo;
+			char _scratch[max_chars];
+			char* const out = ((last - first) >= max_chars) ? first : _scratch;
+			char* end = out;
 
-			GetLocalTime(&_sysinfo);
+			const std::int64_t t = ticks();
+			std::uint64_t magnitude = (t < 0) ? (0 - static_cast<std::uint64_t>(t)) : static_cast<std::uint64_t>(t);
 
-			return year(_sysinfo.wYear);
-		}
+			if (t < 0)
+				*end++ = '-';
 
-	private:
-		unsigned __int64 _value;
-		bool _leap_year;
-		bool _bce;
+			if (magnitude >= static_cast<std::uint64_t>(ticks_per_day))
+			{
+				end = detail::write_unsigned(end, magnitude / ticks_per_day, 1);
+				*end++ = '.';
+				magnitude %= ticks_per_day;
+			}
+
+			const std::uint32_t fraction = static_cast<std::uint32_t>(magnitude % ticks_per_second);
+			const unsigned int seconds = static_cast<unsigned int>(magnitude / ticks_per_second);
+
+			end = detail::write_time(end, seconds / 3600, (seconds / 60) % 60, seconds % 60, fraction, (fraction != 0) ? 7 : 0);
+
+			return (out == first) ? std::to_chars_result{ end, std::errc() } : detail::finish_chars(first, last, _scratch, end);
+		}
 	};
 
-	class date
+	static_assert(sizeof(duration<>) == sizeof(std::int64_t) && std::is_trivially_copyable<duration<>>::value, "duration has to stay a bare tick count");
+
+	/* Day and month names resolve through a perfect hash of the length and the first three lowercased characters.
+	Each slot holds the only spelling that can land in it, so a lookup is one hash and one case-insensitive compare.
+	Single letter days follow the M T W R F S U convention, so S is Saturday and U is Sunday. */
+
+	namespace detail
 	{
-	public:
-		___constexpr20___ date() noexcept = default;
+		struct name_entry
+		{
+			const char* name;
+			unsigned char length;
+			unsigned char index;
+		};
 
-		date(year Y, month M, day d) noexcept
+		struct name_table
 		{
-			_year = std::move(Y);
-			_month = (M == 2 && _year.leap_year()) ? std::move(month(2, M.name(), 29)) : std::move(M);
-			_day = std::move(d);
-		}
+			name_entry slots[64];
+			bool perfect;
+		};
 
-		date(day d, month M, year Y) noexcept
+		___nodiscard___ ___constexpr___ unsigned int name_hash(const char* s, std::size_t length) noexcept
 		{
-			_day = std::move(d);
-			_month = (M == 2 && Y.leap_year()) ? std::move(month(2, M.name(), 29)) : std::move(M);
-			_year = std::move(Y);
+			return static_cast<unsigned int>((static_cast<unsigned char>(s[0]) | 0x20)
+				+ 17 * ((length > 1) ? (static_cast<unsigned char>(s[1]) | 0x20) : 0)
+				+ 3 * ((length > 2) ? (static_cast<unsigned char>(s[2]) | 0x20) : 0)
+				+ 3 * length) & 63;
 		}
 
-		date(month M, day d, year Y) noexcept
+		template <std::size_t N>
+		___nodiscard___ ___constexpr14___ name_table make_name_table(const name_entry (&entries)[N]) noexcept
 		{
-			_month = (M == 2 && Y.leap_year()) ? std::move(month(2, M.name(), 29)) : std::move(M);
-			_day = std::move(d);
-			_year = std::move(Y);
+			name_table table{};
+
+			table.perfect = true;
+
+			for (std::size_t i = 0; i < N; ++i)
+			{
+				name_entry& slot = table.slots[name_hash(entries[i].name, entries[i].length)];
+
+				if (slot.name != nullptr)
+					table.perfect = false;
+
+				slot = entries[i];
+			}
+
+			return table;
 		}
 
-		date(const date& other)
+		inline ___constexpr___ name_entry day_names[] =
 		{
-			_year = other.get_year();
-			_month = other.get_month();
-			_day = other.get_day();
-		}
+			{ "monday", 6, 1 }, { "mon", 3, 1 }, { "m", 1, 1 },
+			{ "tuesday", 7, 2 }, { "tue", 3, 2 }, { "tues", 4, 2 }, { "tu", 2, 2 }, { "t", 1, 2 },
+			{ "wednesday", 9, 3 }, { "wed", 3, 3 }, { "w", 1, 3 },
+			{ "thursday", 8, 4 }, { "thu", 3, 4 }, { "thur", 4, 4 }, { "thurs", 5, 4 }, { "th", 2, 4 }, { "r", 1, 4 },
+			{ "friday", 6, 5 }, { "fri", 3, 5 }, { "f", 1, 5 },
+			{ "saturday", 8, 6 }, { "sat", 3, 6 }, { "sa", 2, 6 }, { "s", 1, 6 },
+			{ "sunday", 6, 7 }, { "sun", 3, 7 }, { "su", 2, 7 }, { "u", 1, 7 }
+		};
 
-		date(date&& other) noexcept
+		inline ___constexpr___ name_entry month_names[] =
 		{
-			_year = std::move(other.get_year());
-			_month = std::move(other.get_month());
-			_day = std::move(other.get_day());
-		}
+			{ "january", 7, 1 }, { "jan", 3, 1 },
+			{ "february", 8, 2 }, { "feb", 3, 2 },
+			{ "march", 5, 3 }, { "mar", 3, 3 },
+			{ "april", 5, 4 }, { "apr", 3, 4 },
+			{ "may", 3, 5 },
+			{ "june", 4, 6 }, { "jun", 3, 6 },
+			{ "july", 4, 7 }, { "jul", 3, 7 },
+			{ "august", 6, 8 }, { "aug", 3, 8 },
+			{ "september", 9, 9 }, { "sep", 3, 9 }, { "sept", 4, 9 },
+			{ "october", 7, 10 }, { "oct", 3, 10 },
+			{ "november", 8, 11 }, { "nov", 3, 11 },
+			{ "december", 8, 12 }, { "dec", 3, 12 }
+		};
 
-		~date() noexcept = default;
+		inline ___constexpr___ name_table day_table = make_name_table(day_names);
+		inline ___constexpr___ name_table month_table = make_name_table(month_names);
 
-		___nodiscard___ year get_year() const
-		{
-			return _year;
-		}
+		static_assert(day_table.perfect, "Day names collide in the name hash!");
+		static_assert(month_table.perfect, "Month names collide in the name hash!");
 
-		___nodiscard___ month get_month() const
+		/* Canonical names by index, slot 0 belongs to default constructed objects */
+		inline ___constexpr___ std::string_view day_display_names[8] =
 		{
-			return _month;
-		}
+			"", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday", "Sunday"
+		};
 
-		___nodiscard___ day get_day() const
+		inline ___constexpr___ std::string_view month_display_names[13] =
 		{
-			return _day;
-		}
+			"", "January", "February", "March", "April", "May", "June",
+			"July", "August", "September", "October", "November", "December"
+		};
 
-		const date& operator= (const date& other)
+		/* Returns the day's week index or the month's index, or 0 for an unknown name */
+		___nodiscard___ ___constexpr14___ unsigned short int lookup_name(const name_table& table, std::string_view name) noexcept
 		{
-			_year = other.get_year();
-			_month = other.get_month();
-			_day = other.get_day();
+			if ((name.size() - 1) >= 9)
+				return 0;
 
-			return *this;
-		}
+			const name_entry& slot = table.slots[name_hash(name.data(), name.size())];
 
-		const date& operator= (date&& other) noexcept
-		{
-			_year = std::move(other.get_year());
-			_month = std::move(other.get_month());
-			_day = std::move(other.get_day());
+			if (slot.length != name.size())
+				return 0;
 
-			return *this;
-		}
+			for (std::size_t i = 0; i < name.size(); ++i)
+			{
+				if ((static_cast<unsigned char>(name[i]) | 0x20) != static_cast<unsigned char>(slot.name[i]))
+					return 0;
+			}
 
-		___nodiscard___ static date now()
-		{
-			return date(year::now(), month::now(), day::now());
+			return slot.index;
 		}
+	}
 
-	private:
-		year _year;
-		month _month;
-		day _day;
-	};
-
-	class date_time
+	class day
 	{
 	public:
-		___constexpr20___ date_time() noexcept = default;
-
-		date_time(year Y, month M, day D, unsigned short hrs, unsigned short min, unsigned short sec, unsigned short mil) : 
-			_date(std::move(date(Y, M, D))), _time(std::move(time(hrs, min, sec, mil))) 
-		{}
-
-		date_time(date D, time T) : _date(std::move(D)), _time(std::move(T)) {}
+		___constexpr20___ day() noexcept : _week_index(0), _month_index(0) {}
 
-		date_time(time T, date D)
+		/* The name is only checked against the week index, it is never stored */
+		___constexpr20___ day(std::string_view name, unsigned short int week_index, unsigned short int month_index) : day(week_index, month_index)
 		{
-			_time = std::move(T);
-			_date = std::move(D);
+			if (detail::lookup_name(detail::day_table, name) != _week_index)
+				throw basic_error("Invalid name!");
 		}
 
-		date_time(const date_time& other) noexcept
+		___constexpr20___ day(unsigned short int week_index, unsigned short int month_index)
 		{
-			_date = other.get_date();
-			_time = other.get_time();
+			if ((week_index > 7) || (week_index < 1))
+				throw basic_error("Invalid week index!");
+
+			if ((month_index > 31) || (month_index < 1))
+				throw basic_error("Invalid week index!");
+
+			_week_index = week_index;
+			_month_index = month_index;
 		}
 
-		date_time(date_time&& other) noexcept
+		day(std::string_view name)
 		{
-			_date = std::move(other.get_date());
-			_time = std::move(other.get_time());
+			_week_index = detail::lookup_name(detail::day_table, name);
+
+			if (_week_index == 0)
+				throw basic_error("Invalid name!");
+
+			_month_index = 0;
 		}
 
-		~date_time() noexcept = default;
+		day(const day& other) noexcept = default;
+		day(day&& other) noexcept = default;
 
-		___nodiscard___ date get_date() const
+		~day() noexcept = default;
+
+		/* Points into a static table, the view never dangles */
+		___nodiscard___ ___constexpr___ std::string_view name() const noexcept
 		{
-			return _date;
+			return detail::day_display_names[_week_index];
 		}
 
-		___nodiscard___ time get_time() const
+		___nodiscard___ ___constexpr___ unsigned short int week_index() const
 		{
-			return _time;
+			return _week_index;
 		}
 
-		const date_time& operator= (const date_time& other) noexcept
+		___nodiscard___ ___constexpr___ unsigned short int month_index() const
 		{
-			_date = other.get_date();
-			_time = other.get_time();
-
-			return *this;
+			return _month_index;
 		}
 
-		const date_time& operator= (date_time&& other) noexcept
+		day& operator= (const day& other) noexcept = default;
+		day& operator= (day&& other) noexcept = default;
+
+		___constexpr14___ const day& operator= (std::pair<unsigned short int, unsigned short int> day_indexes)
 		{
-			_date = std::move(other.get_date());
-			_time = std::move(other.get_time());
+			if ((day_indexes.first > 7) || (day_indexes.first < 1))
+				throw basic_error("Invalid week index!");
+
+			if ((day_indexes.second > 31) || (day_indexes.second < 1))
+				throw basic_error("Invalid week index!");
+
+			_week_index = day_indexes.first;
+			_month_index = day_indexes.second;
 
 			return *this;
 		}
 
-		___nodiscard___ static date_time now()
+		const day& operator= (std::string_view name)
 		{
-			return date_time(date::now(), time::now());
+			const unsigned short int week_index = detail::lookup_name(detail::day_table, name);
+
+			if (week_index == 0)
+				throw basic_error("Invalid name!");
+
+			_week_index = week_index;
+			_month_index = 0;
+
+			return *this;
+		}
+
+		___nodiscard___ static day now(clock_source source = clock_source::realtime)
+		{
+			const std::int64_t days = days_from_ticks(local_ticks(source));
+
+			return day(weekday_from_days(days), civil_from_days(days).d);
+		}
+
+		/* Days order by the day of the month first, the week index only breaks ties */
+		___nodiscard___ ___constexpr___ std::uint32_t order_key() const noexcept
+		{
+			return (static_cast<std::uint32_t>(_month_index) << 16) | _week_index;
+		}
+
+		___nodiscard___ ___constexpr___ bool operator== (const day& other) const noexcept
+		{
+			return order_key() == other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator!= (const day& other) const noexcept
+		{
+			return order_key() != other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator< (const day& other) const noexcept
+		{
+			return order_key() < other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator<= (const day& other) const noexcept
+		{
+			return order_key() <= other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator> (const day& other) const noexcept
+		{
+			return order_key() > other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator>= (const day& other) const noexcept
+		{
+			return order_key() >= other.order_key();
+		}
+
+#if ___cpp20___
+		___nodiscard___ ___constexpr___ std::strong_ordering operator<=> (const day& other) const noexcept
+		{
+			return order_key() <=> other.order_key();
+		}
+#endif
+
+	private:
+		unsigned short int _week_index;
+		unsigned short int _month_index;
+	};
+
+	class month
+	{
+	public:
+		___constexpr20___ month() noexcept : _index(0), _days(0) 
+		{}
+
+		/* The name is only checked against the index, it is never stored */
+		___constexpr20___ month(unsigned short int index, std::string_view name, unsigned short int days) : month(index)
+		{
+			if (detail::lookup_name(detail::month_table, name) != _index)
+				throw basic_error("Invalid month name!");
+
+			if ((days != _days) && ((_index != 2) || (days != 29)))
+				throw basic_error("Invalid ammount of days for month!");
+
+			_days = days;
+		}
+
+		month(std::string_view name, unsigned short int index, unsigned short int days) : month(index, name, days)
+		{}
+
+		___constexpr20___ month(unsigned short int index)
+		{
+			if ((index > 12) || (index < 1))
+				throw basic_error("Invalid month index!");
+
+			_index = index;
+			_days = days_in_month(2001, index);
+		}
+
+		month(std::string_view name)
+		{
+			_index = detail::lookup_name(detail::month_table, name);
+
+			if (_index == 0)
+				throw basic_error("Invalid month name!");
+
+			_days = days_in_month(2001, _index);
+		}
+
+		month(const month& other) noexcept = default;
+		month(month&& other) noexcept = default;
+
+		~month() noexcept = default;
+
+		___nodiscard___ ___constexpr___ unsigned short int index() const
+		{
+			return _index;
+		}
+
+		/* Points into a static table, the view never dangles */
+		___nodiscard___ ___constexpr___ std::string_view name() const noexcept
+		{
+			return detail::month_display_names[_index];
+		}
+
+		___nodiscard___ ___constexpr___ unsigned short int days() const
+		{
+			return _days;
+		}
+
+		month& operator= (const month& other) noexcept = default;
+		month& operator= (month&& other) noexcept = default;
+
+		const month& operator= (unsigned short int index)
+		{
+			*this = month(index);
+
+			return *this;
+		}
+
+		const month& operator= (std::string_view name)
+		{
+			const unsigned short int index = detail::lookup_name(detail::month_table, name);
+
+			if (index == 0)
+				throw basic_error("Invalid month name!");
+
+			_index = index;
+			_days = days_in_month(2001, _index);
+
+			return *this;
+		}
+
+		___nodiscard___ static month now(clock_source source = clock_source::realtime)
+		{
+			return month(civil_from_days(days_from_ticks(local_ticks(source))).m);
+		}
+
+		___nodiscard___ ___constexpr___ std::uint32_t order_key() const noexcept
+		{
+			return (static_cast<std::uint32_t>(_index) << 16) | _days;
+		}
+
+		___nodiscard___ ___constexpr___ bool operator== (const month& other) const noexcept
+		{
+			return (_index == other.index()) && (_days == other.days());
+		}
+
+		___nodiscard___ ___constexpr___ bool operator!= (const month& other) const noexcept
+		{
+			return order_key() != other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator< (const month& other) const noexcept
+		{
+			return order_key() < other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator<= (const month& other) const noexcept
+		{
+			return order_key() <= other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator> (const month& other) const noexcept
+		{
+			return order_key() > other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator>= (const month& other) const noexcept
+		{
+			return order_key() >= other.order_key();
+		}
+
+#if ___cpp20___
+		___nodiscard___ ___constexpr___ std::strong_ordering operator<=> (const month& other) const noexcept
+		{
+			return order_key() <=> other.order_key();
+		}
+#endif
+
+		___nodiscard___ bool operator== (std::string_view other) const
+		{
+			return name() == other;
+		}
+
+		___nodiscard___ ___constexpr14___ bool operator== (const unsigned short int& other) const
+		{
+			if (_index == other)
+				return true;
+
+			return false;
+		}
+
+	private:
+		unsigned short int _index;
+		unsigned short int _days;
+	};
+
+	class year
+	{
+	public:
+		___constexpr20___ year() noexcept : _value(0), _leap_year(false), _bce(false) {}
+
+		year(std::uint64_t value, bool leap_year, bool bce)
+		{
+			if ((leap_year == true) && !is_leap_year(bce ? (1 - static_cast<std::int64_t>(value)) : static_cast<std::int64_t>(value)))
+				throw basic_error("Year is not a leap year!");
+
+			_value = std::move(value);
+			_leap_year = std::move(leap_year);
+			_bce = std::move(bce);
+		}
+
+		___constexpr20___ year(std::uint64_t value, bool bce)
+		{
+			_value = std::move(value);
+			_bce = std::move(bce);
+			_leap_year = is_leap_year(astronomical());
+		}
+
+		year(std::uint64_t value)
+		{
+			_value = std::move(value);
+			_bce = false;
+			_leap_year = is_leap_year(astronomical());
+		}
+
+		year(const year& other) noexcept = default;
+		year(year&& other) noexcept = default;
+
+		~year() noexcept = default;
+
+		___nodiscard___ ___constexpr___ std::uint64_t value() const
+		{
+			return _value;
+		}
+
+		___nodiscard___ ___constexpr___ bool leap_year() const
+		{
+			return _leap_year;
+		}
+
+		___nodiscard___ ___constexpr___ bool bce() const
+		{
+			return _bce;
+		}
+
+		/* 1 BCE is year 0, 2 BCE is year -1 and so on */
+		___nodiscard___ ___constexpr___ std::int64_t astronomical() const
+		{
+			return _bce ? (1 - static_cast<std::int64_t>(_value)) : static_cast<std::int64_t>(_value);
+		}
+
+		year& operator= (const year& other) noexcept = default;
+		year& operator= (year&& other) noexcept = default;
+
+		const year& operator= (std::uint64_t other)
+		{
+			_value = std::move(other);
+			_bce = false;
+			_leap_year = is_leap_year(astronomical());
+
+			return *this;
+		}
+
+		___nodiscard___ static year now(clock_source source = clock_source::realtime)
+		{
+			const std::int64_t y = civil_from_days(days_from_ticks(local_ticks(source))).y;
+
+			return (y > 0) ? year(static_cast<std::uint64_t>(y), false) : year(static_cast<std::uint64_t>(1 - y), true);
+		}
+
+		___nodiscard___ ___constexpr___ std::int64_t order_key() const noexcept
+		{
+			return astronomical();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator== (const year& other) const noexcept
+		{
+			return order_key() == other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator!= (const year& other) const noexcept
+		{
+			return order_key() != other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator< (const year& other) const noexcept
+		{
+			return order_key() < other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator<= (const year& other) const noexcept
+		{
+			return order_key() <= other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator> (const year& other) const noexcept
+		{
+			return order_key() > other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator>= (const year& other) const noexcept
+		{
+			return order_key() >= other.order_key();
+		}
+
+#if ___cpp20___
+		___nodiscard___ ___constexpr___ std::strong_ordering operator<=> (const year& other) const noexcept
+		{
+			return order_key() <=> other.order_key();
+		}
+#endif
+
+	private:
+		std::uint64_t _value;
+		bool _leap_year;
+		bool _bce;
+	};
+
+	class date
+	{
+	public:
+		static ___constexpr___ std::ptrdiff_t max_chars = 32;
+
+		___constexpr20___ date() noexcept = default;
+
+		___constexpr20___ date(year Y, month M, day d) noexcept
+		{
+			_year = std::move(Y);
+			_month = (M == 2 && _year.leap_year()) ? std::move(month(2, M.name(), 29)) : std::move(M);
+			_day = std::move(d);
+
+			_sync_week_index();
+		}
+
+		___constexpr20___ date(day d, month M, year Y) noexcept
+		{
+			_day = std::move(d);
+			_month = (M == 2 && Y.leap_year()) ? std::move(month(2, M.name(), 29)) : std::move(M);
+			_year = std::move(Y);
+
+			_sync_week_index();
+		}
+
+		___constexpr20___ date(month M, day d, year Y) noexcept
+		{
+			_month = (M == 2 && Y.leap_year()) ? std::move(month(2, M.name(), 29)) : std::move(M);
+			_day = std::move(d);
+			_year = std::move(Y);
+
+			_sync_week_index();
+		}
+
+		date(const date& other) noexcept = default;
+		date(date&& other) noexcept = default;
+
+		~date() noexcept = default;
+
+		___nodiscard___ ___constexpr20___ year get_year() const
+		{
+			return _year;
+		}
+
+		___nodiscard___ ___constexpr20___ month get_month() const
+		{
+			return _month;
+		}
+
+		___nodiscard___ ___constexpr20___ day get_day() const
+		{
+			return _day;
+		}
+
+		date& operator= (const date& other) noexcept = default;
+		date& operator= (date&& other) noexcept = default;
+
+		___nodiscard___ static date now(clock_source source = clock_source::realtime)
+		{
+			return from_days(days_from_ticks(local_ticks(source)));
+		}
+
+		/* Serial day number, 1970-01-01 is day 0 */
+		___nodiscard___ ___constexpr14___ std::int64_t days_since_epoch() const noexcept
+		{
+			return days_from_civil(_year.astronomical(), _month.index(), _day.month_index());
+		}
+
+		___nodiscard___ ___constexpr14___ unsigned short int weekday() const noexcept
+		{
+			return weekday_from_days(days_since_epoch());
+		}
+
+		___nodiscard___ unsigned short int day_of_year() const noexcept
+		{
+			return dt0::day_of_year(_year.astronomical(), _month.index(), _day.month_index());
+		}
+
+		___nodiscard___ date add_days(std::int64_t days) const
+		{
+			return from_days(days_since_epoch() + days);
+		}
+
+		/* The day of month is clamped, 2024-01-31 plus one month is 2024-02-29 */
+		___nodiscard___ date add_months(std::int64_t months) const
+		{
+			return from_days(add_months_to_ticks(days_since_epoch() * ticks_per_day, months) / ticks_per_day);
+		}
+
+		___nodiscard___ date add_years(std::int64_t years) const
+		{
+			return add_months(years * 12);
+		}
+
+		___nodiscard___ std::int64_t days_until(const date& other) const noexcept
+		{
+			return other.days_since_epoch() - days_since_epoch();
+		}
+
+		___nodiscard___ std::int64_t months_until(const date& other) const noexcept
+		{
+			return months_between_ticks(days_since_epoch() * ticks_per_day, other.days_since_epoch() * ticks_per_day);
+		}
+
+		___nodiscard___ std::int64_t years_until(const date& other) const noexcept
+		{
+			return months_until(other) / 12;
+		}
+
+		/* YYYY-MM-DD, nothing is allocated */
+		std::to_chars_result to_chars(char* first, char* last) const noexcept
+		{
+			char _scratch[max_chars];
+			char* const out = ((last - first) >= max_chars) ? first : _scratch;
+			char* const end = detail::write_date(out, _year.astronomical(), _month.index(), _day.month_index());
+
+			return (out == first) ? std::to_chars_result{ end, std::errc() } : detail::finish_chars(first, last, _scratch, end);
+		}
+
+		___nodiscard___ static date from_days(std::int64_t days)
+		{
+			const civil_date C = civil_from_days(days);
+
+			const year Y = (C.y > 0) ? year(static_cast<std::uint64_t>(C.y), false) : year(static_cast<std::uint64_t>(1 - C.y), true);
+
+			return date(Y, month(C.m), day(weekday_from_days(days), C.d));
+		}
+
+		/* Exact for astronomical years within +-2^54, which covers anything a tick count can reach */
+		___nodiscard___ ___constexpr___ std::int64_t order_key() const noexcept
+		{
+			return _year.astronomical() * 512 + _month.index() * 32 + _day.month_index();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator== (const date& other) const noexcept
+		{
+			return order_key() == other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator!= (const date& other) const noexcept
+		{
+			return order_key() != other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator< (const date& other) const noexcept
+		{
+			return order_key() < other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator<= (const date& other) const noexcept
+		{
+			return order_key() <= other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator> (const date& other) const noexcept
+		{
+			return order_key() > other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator>= (const date& other) const noexcept
+		{
+			return order_key() >= other.order_key();
+		}
+
+#if ___cpp20___
+		___nodiscard___ ___constexpr___ std::strong_ordering operator<=> (const date& other) const noexcept
+		{
+			return order_key() <=> other.order_key();
+		}
+#endif
+
+	private:
+		/* The week index handed in with the day is not trusted, it is derived from the calendar instead */
+		___constexpr14___ void _sync_week_index() noexcept
+		{
+			if ((_month.index() < 1) || (_month.index() > 12) || (_day.month_index() < 1))
+				return;
+
+			_day = std::pair<unsigned short int, unsigned short int>(weekday(), _day.month_index());
+		}
+
+		year _year;
+		month _month;
+		day _day;
+	};
+
+	class date_time
+	{
+	public:
+		static ___constexpr___ std::ptrdiff_t max_chars = 48;
+
+		___constexpr20___ date_time() noexcept = default;
+
+		date_time(year Y, month M, day D, unsigned short hrs, unsigned short min, unsigned short sec, unsigned short mil) : 
+			_date(std::move(date(Y, M, D))), _time(std::move(time(hrs, min, sec, mil))) 
+		{}
+
+		___constexpr20___ date_time(date D, time T) : _date(std::move(D)), _time(std::move(T)) {}
+
+		date_time(time T, date D)
+		{
+			_time = std::move(T);
+			_date = std::move(D);
+		}
+
+		date_time(const date_time& other) noexcept = default;
+		date_time(date_time&& other) noexcept = default;
+
+		~date_time() noexcept = default;
+
+		___nodiscard___ ___constexpr20___ date get_date() const
+		{
+			return _date;
+		}
+
+		___nodiscard___ ___constexpr20___ time get_time() const
+		{
+			return _time;
+		}
+
+		date_time& operator= (const date_time& other) noexcept = default;
+		date_time& operator= (date_time&& other) noexcept = default;
+
+		/* Ticks since 1970-01-01 00:00:00, all the arithmetic below goes through this linear form */
+		___nodiscard___ std::int64_t ticks() const noexcept
+		{
+			return _date.days_since_epoch() * ticks_per_day
+				+ _time.hours() * ticks_per_hour
+				+ _time.minutes() * ticks_per_minute
+				+ _time.seconds() * ticks_per_second
+				+ _time.milliseconds() * ticks_per_millisecond;
+		}
+
+		___nodiscard___ duration<> time_since_epoch() const noexcept
+		{
+			return duration<>(ticks());
+		}
+
+		/* std::chrono::sys_time<tick_duration> under C++20, system_clock counts from 1970 too */
+		___nodiscard___ std::chrono::time_point<std::chrono::system_clock, tick_duration> to_sys_time() const noexcept
+		{
+			return std::chrono::time_point<std::chrono::system_clock, tick_duration>(tick_duration(ticks()));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ static date_time from_time_since_epoch(std::chrono::duration<Rep, Period> d)
+		{
+			return from_ticks(to_ticks(d));
+		}
+
+		template <class Duration>
+		___nodiscard___ static date_time from_sys_time(std::chrono::time_point<std::chrono::system_clock, Duration> point)
+		{
+			return from_ticks(to_ticks(point.time_since_epoch()));
+		}
+
+		/* The time only keeps milliseconds, so durations are effectively truncated to them */
+		template <class Rep, class Period>
+		date_time& operator+= (std::chrono::duration<Rep, Period> d)
+		{
+			return *this = from_ticks(ticks() + to_ticks(d));
+		}
+
+		template <class Rep, class Period>
+		date_time& operator-= (std::chrono::duration<Rep, Period> d)
+		{
+			return *this = from_ticks(ticks() - to_ticks(d));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ date_time operator+ (std::chrono::duration<Rep, Period> d) const
+		{
+			return from_ticks(ticks() + to_ticks(d));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ date_time operator- (std::chrono::duration<Rep, Period> d) const
+		{
+			return from_ticks(ticks() - to_ticks(d));
+		}
+
+		___nodiscard___ duration<> operator- (const date_time& other) const noexcept
+		{
+			return duration<>(ticks() - other.ticks());
+		}
+
+		___nodiscard___ date_time add_days(std::int64_t days) const
+		{
+			return from_ticks(ticks() + days * ticks_per_day);
+		}
+
+		___nodiscard___ date_time add_months(std::int64_t months) const
+		{
+			return from_ticks(add_months_to_ticks(ticks(), months));
+		}
+
+		___nodiscard___ date_time add_years(std::int64_t years) const
+		{
+			return add_months(years * 12);
+		}
+
+		/* Truncated toward zero like duration_cast, until<std::chrono::hours>(other) counts whole hours */
+		template <class Duration>
+		___nodiscard___ Duration until(const date_time& other) const noexcept
+		{
+			return std::chrono::duration_cast<Duration>(other - *this);
+		}
+
+		___nodiscard___ std::int64_t months_until(const date_time& other) const noexcept
+		{
+			return months_between_ticks(ticks(), other.ticks());
+		}
+
+		___nodiscard___ std::int64_t years_until(const date_time& other) const noexcept
+		{
+			return months_until(other) / 12;
+		}
+
+		___nodiscard___ date_time floor(time_unit unit) const
+		{
+			return from_ticks(floor_ticks(ticks(), unit));
+		}
+
+		___nodiscard___ date_time ceil(time_unit unit) const
+		{
+			return from_ticks(ceil_ticks(ticks(), unit));
+		}
+
+		___nodiscard___ std::int64_t bucket(time_unit unit) const noexcept
+		{
+			return bucket_of(ticks(), unit);
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ date_time floor(std::chrono::duration<Rep, Period> width) const
+		{
+			return from_ticks(floor_ticks(ticks(), to_ticks(width)));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ date_time ceil(std::chrono::duration<Rep, Period> width) const
+		{
+			return from_ticks(ceil_ticks(ticks(), to_ticks(width)));
+		}
+
+		/* YYYY-MM-DDTHH:MM:SS.mmm with a trailing Z when utc is set, nothing is allocated */
+		std::to_chars_result to_chars(char* first, char* last, bool utc = false) const noexcept
+		{
+			char _scratch[max_chars];
+			char* const out = ((last - first) >= max_chars) ? first : _scratch;
+
+			char* end = detail::write_date(out, _date.get_year().astronomical(), _date.get_month().index(), _date.get_day().month_index());
+			*end++ = 'T';
+
+			const time T = _time;
+			end = detail::write_time(end, T.hours(), T.minutes(), T.seconds(), T.milliseconds(), 3);
+
+			if (utc)
+				*end++ = 'Z';
+
+			return (out == first) ? std::to_chars_result{ end, std::errc() } : detail::finish_chars(first, last, _scratch, end);
+		}
+
+		/* Both now() variants read the clock once so the date and the time always belong to the same instant */
+		___nodiscard___ static date_time now(clock_source source = clock_source::realtime)
+		{
+			return from_ticks(local_ticks(source));
+		}
+
+		___nodiscard___ static date_time utc_now(clock_source source = clock_source::realtime)
+		{
+			return from_ticks(utc_ticks(source));
+		}
+
+		___nodiscard___ static date_time from_ticks(std::int64_t ticks)
+		{
+			return date_time(date::from_days(days_from_ticks(ticks)), time::from_ticks(ticks));
+		}
+
+		___nodiscard___ ___constexpr20___ bool operator== (const date_time& other) const noexcept
+		{
+			return (_date == other._date) && (_time == other._time);
+		}
+
+		___nodiscard___ ___constexpr20___ bool operator!= (const date_time& other) const noexcept
+		{
+			return !(*this == other);
+		}
+
+		___nodiscard___ ___constexpr20___ bool operator< (const date_time& other) const noexcept
+		{
+			return (_date != other._date) ? (_date < other._date) : (_time < other._time);
+		}
+
+		___nodiscard___ ___constexpr20___ bool operator<= (const date_time& other) const noexcept
+		{
+			return !(other < *this);
+		}
+
+		___nodiscard___ ___constexpr20___ bool operator> (const date_time& other) const noexcept
+		{
+			return other < *this;
+		}
+
+		___nodiscard___ ___constexpr20___ bool operator>= (const date_time& other) const noexcept
+		{
+			return !(*this < other);
+		}
+
+#if ___cpp20___
+		___nodiscard___ ___constexpr20___ std::strong_ordering operator<=> (const date_time& other) const noexcept
+		{
+			const std::strong_ordering order = _date <=> other._date;
+
+			return (order != 0) ? order : (_time <=> other._time);
+		}
+#endif
+
+	private:
+		date _date;
+		time _time;
+	};
+
+	/* A packed alternative to date_time, it is a single count of 100 nanosecond ticks since 1970-01-01 00:00:00.
+	It is 8 bytes and trivially copyable so arrays of it can be memcpy-ed, the date and time are derived on demand. */
+
+	class timestamp
+	{
+	public:
+		using rep = std::int64_t;
+
+		static ___constexpr___ rep ticks_per_millisecond = dt0::ticks_per_millisecond;
+		static ___constexpr___ rep ticks_per_second = dt0::ticks_per_second;
+		static ___constexpr___ rep ticks_per_minute = dt0::ticks_per_minute;
+		static ___constexpr___ rep ticks_per_hour = dt0::ticks_per_hour;
+		static ___constexpr___ rep ticks_per_day = dt0::ticks_per_day;
+
+		static ___constexpr___ std::ptrdiff_t max_chars = 32;
+
+		___constexpr___ timestamp() noexcept : _ticks(0) {}
+
+		explicit ___constexpr___ timestamp(rep ticks) noexcept : _ticks(ticks) {}
+
+		timestamp(const date& D, const time& T)
+		{
+			const unsigned short int M = D.get_month().index();
+			const unsigned short int d = D.get_day().month_index();
+
+			if ((M < 1) || (M > 12) || (d < 1) || (d > 31))
+				throw basic_error("Invalid date!");
+
+			_ticks = D.days_since_epoch() * ticks_per_day
+				+ T.hours() * ticks_per_hour
+				+ T.minutes() * ticks_per_minute
+				+ T.seconds() * ticks_per_second
+				+ T.milliseconds() * ticks_per_millisecond;
+		}
+
+		timestamp(const date_time& other) : timestamp(other.get_date(), other.get_time()) {}
+
+		___nodiscard___ ___constexpr___ rep ticks() const noexcept
+		{
+			return _ticks;
+		}
+
+		___nodiscard___ ___constexpr___ duration<> time_since_epoch() const noexcept
+		{
+			return duration<>(_ticks);
+		}
+
+		___nodiscard___ ___constexpr___ std::chrono::time_point<std::chrono::system_clock, tick_duration> to_sys_time() const noexcept
+		{
+			return std::chrono::time_point<std::chrono::system_clock, tick_duration>(tick_duration(_ticks));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ static ___constexpr___ timestamp from_time_since_epoch(std::chrono::duration<Rep, Period> d) noexcept
+		{
+			return timestamp(to_ticks(d));
+		}
+
+		template <class Duration>
+		___nodiscard___ static ___constexpr___ timestamp from_sys_time(std::chrono::time_point<std::chrono::system_clock, Duration> point) noexcept
+		{
+			return timestamp(to_ticks(point.time_since_epoch()));
+		}
+
+		___nodiscard___ ___constexpr___ std::int64_t days_since_epoch() const noexcept
+		{
+			return days_from_ticks(_ticks);
+		}
+
+		___nodiscard___ ___constexpr14___ unsigned short int weekday() const noexcept
+		{
+			return weekday_from_days(days_since_epoch());
+		}
+
+		___nodiscard___ ___constexpr___ rep time_of_day() const noexcept
+		{
+			return _ticks - days_since_epoch() * ticks_per_day;
+		}
+
+		___nodiscard___ date get_date() const
+		{
+			return date::from_days(days_since_epoch());
+		}
+
+		___nodiscard___ time get_time() const
+		{
+			return time::from_ticks(_ticks);
+		}
+
+		___nodiscard___ date_time to_date_time() const
+		{
+			return date_time(get_date(), get_time());
+		}
+
+		template <class Rep, class Period>
+		___constexpr14___ timestamp& operator+= (std::chrono::duration<Rep, Period> d) noexcept
+		{
+			_ticks += to_ticks(d);
+
+			return *this;
+		}
+
+		template <class Rep, class Period>
+		___constexpr14___ timestamp& operator-= (std::chrono::duration<Rep, Period> d) noexcept
+		{
+			_ticks -= to_ticks(d);
+
+			return *this;
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ ___constexpr___ timestamp operator+ (std::chrono::duration<Rep, Period> d) const noexcept
+		{
+			return timestamp(_ticks + to_ticks(d));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ ___constexpr___ timestamp operator- (std::chrono::duration<Rep, Period> d) const noexcept
+		{
+			return timestamp(_ticks - to_ticks(d));
+		}
+
+		___nodiscard___ ___constexpr___ duration<> operator- (const timestamp& other) const noexcept
+		{
+			return duration<>(_ticks - other._ticks);
+		}
+
+		___nodiscard___ ___constexpr___ timestamp add_days(std::int64_t days) const noexcept
+		{
+			return timestamp(_ticks + days * ticks_per_day);
+		}
+
+		___nodiscard___ ___constexpr14___ timestamp add_months(std::int64_t months) const noexcept
+		{
+			return timestamp(add_months_to_ticks(_ticks, months));
+		}
+
+		___nodiscard___ ___constexpr14___ timestamp add_years(std::int64_t years) const noexcept
+		{
+			return add_months(years * 12);
+		}
+
+		template <class Duration>
+		___nodiscard___ ___constexpr___ Duration until(const timestamp& other) const noexcept
+		{
+			return std::chrono::duration_cast<Duration>(other - *this);
+		}
+
+		___nodiscard___ ___constexpr14___ std::int64_t months_until(const timestamp& other) const noexcept
+		{
+			return months_between_ticks(_ticks, other._ticks);
+		}
+
+		___nodiscard___ ___constexpr14___ std::int64_t years_until(const timestamp& other) const noexcept
+		{
+			return months_until(other) / 12;
+		}
+
+		___nodiscard___ ___constexpr14___ timestamp floor(time_unit unit) const noexcept
+		{
+			return timestamp(floor_ticks(_ticks, unit));
+		}
+
+		___nodiscard___ ___constexpr14___ timestamp ceil(time_unit unit) const noexcept
+		{
+			return timestamp(ceil_ticks(_ticks, unit));
+		}
+
+		___nodiscard___ ___constexpr14___ std::int64_t bucket(time_unit unit) const noexcept
+		{
+			return bucket_of(_ticks, unit);
+		}
+
+		/* Fixed width windows aligned on the epoch, floor(std::chrono::minutes(15)) */
+		template <class Rep, class Period>
+		___nodiscard___ ___constexpr14___ timestamp floor(std::chrono::duration<Rep, Period> width) const noexcept
+		{
+			return timestamp(floor_ticks(_ticks, to_ticks(width)));
+		}
+
+		template <class Rep, class Period>
+		___nodiscard___ ___constexpr14___ timestamp ceil(std::chrono::duration<Rep, Period> width) const noexcept
+		{
+			return timestamp(ceil_ticks(_ticks, to_ticks(width)));
+		}
+
+		/* RFC 3339 text, YYYY-MM-DDTHH:MM:SS followed by precision (0 to 7) fraction digits and a Z when utc is set.
+		Nothing is allocated. */
+		std::to_chars_result to_chars(char* first, char* last, unsigned int precision = 3, bool utc = false) const noexcept
+		{
+			if (precision > 7)
+				precision = 7;
+
+			char _scratch[max_chars];
+			char* const out = ((last - first) >= max_chars) ? first : _scratch;
+
+			const std::int64_t days = days_since_epoch();
+			const civil_date C = civil_from_days(days);
+			const rep tod = _ticks - days * ticks_per_day;
+			const std::uint32_t fraction = static_cast<std::uint32_t>(tod % ticks_per_second) / detail::powers_of_ten[7 - precision];
+
+			char* end = detail::write_date(out, C.y, C.m, C.d);
+			*end++ = 'T';
+			end = detail::write_time(end, static_cast<unsigned int>(tod / ticks_per_hour), static_cast<unsigned int>((tod / ticks_per_minute) % 60),
+				static_cast<unsigned int>((tod / ticks_per_second) % 60), fraction, precision);
+
+			if (utc)
+				*end++ = 'Z';
+
+			return (out == first) ? std::to_chars_result{ end, std::errc() } : detail::finish_chars(first, last, _scratch, end);
+		}
+
+		___nodiscard___ static timestamp now(clock_source source = clock_source::realtime) noexcept
+		{
+			return timestamp(local_ticks(source));
+		}
+
+		___nodiscard___ static timestamp utc_now(clock_source source = clock_source::realtime) noexcept
+		{
+			return timestamp(utc_ticks(source));
+		}
+
+		___nodiscard___ ___constexpr___ rep order_key() const noexcept
+		{
+			return _ticks;
+		}
+
+		___nodiscard___ ___constexpr___ bool operator== (const timestamp& other) const noexcept
+		{
+			return order_key() == other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator!= (const timestamp& other) const noexcept
+		{
+			return order_key() != other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator< (const timestamp& other) const noexcept
+		{
+			return order_key() < other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator<= (const timestamp& other) const noexcept
+		{
+			return order_key() <= other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator> (const timestamp& other) const noexcept
+		{
+			return order_key() > other.order_key();
+		}
+
+		___nodiscard___ ___constexpr___ bool operator>= (const timestamp& other) const noexcept
+		{
+			return order_key() >= other.order_key();
+		}
+
+#if ___cpp20___
+		___nodiscard___ ___constexpr___ std::strong_ordering operator<=> (const timestamp& other) const noexcept
+		{
+			return order_key() <=> other.order_key();
 		}
+#endif
 
 	private:
-		date _date;
-		time _time;
+		rep _ticks;
+	};
+
+	static_assert(std::is_trivially_copyable<date>::value, "date must stay trivially copyable");
+	static_assert(std::is_trivially_copyable<date_time>::value, "date_time must stay trivially copyable");
+
+	static_assert(sizeof(timestamp) == 8, "timestamp must stay a single 64 bit word");
+	static_assert(std::is_trivially_copyable<timestamp>::value, "timestamp must stay trivially copyable");
+
+	/* ISO 8601 / RFC 3339 parsing, YYYY-MM-DD optionally followed by T (or t or a space) and hh:mm[:ss[.fffffff]]
+	and a Z or a +hh:mm / -hh:mm / +hhmm / +hh offset. Text with an offset is converted to UTC, text without one is kept as is.
+	Like std::from_chars the parse stops at the first byte that does not belong to the timestamp and on failure ptr is the first offending byte. */
+
+	namespace detail
+	{
+		struct iso_fields
+		{
+			std::int64_t y;
+			unsigned int m, d, h, mi, s;
+			std::int64_t fraction;
+			std::int64_t offset;
+		};
+
+		inline bool read_digits(const char* p, const char* last, unsigned int count, unsigned int& value) noexcept
+		{
+			if (last - p < static_cast<std::ptrdiff_t>(count))
+				return false;
+
+			value = 0;
+
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				const unsigned int digit = static_cast<unsigned int>(static_cast<unsigned char>(p[i]) - '0');
+
+				if (digit > 9)
+					return false;
+
+				value = value * 10 + digit;
+			}
+
+			return true;
+		}
+
+		inline const char* first_non_digit(const char* p, const char* last, unsigned int count) noexcept
+		{
+			for (const char* q = p; (q < last) && (q < p + count); ++q)
+			{
+				if (static_cast<unsigned int>(static_cast<unsigned char>(*q) - '0') > 9)
+					return q;
+			}
+
+			return (last < p + count) ? last : p + count;
+		}
+
+		/* The common YYYY-MM-DDThh:mm head, all 16 digits and separators are checked with one compare per class.
+		It needs 16 readable bytes and returns false for anything unusual, which then goes through the scalar path. */
+		inline bool parse_iso_head_simd(const char* p, iso_fields& f) noexcept
+		{
+#if ___sse2___
+			const __m128i text = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i digits = _mm_sub_epi8(text, _mm_set1_epi8('0'));
+			const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digits, _mm_set1_epi8(9)), digits);
+
+			const __m128i digit_lanes = _mm_setr_epi8(-1, -1, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1, 0, -1, -1);
+			const __m128i separators = _mm_setr_epi8(0, 0, 0, 0, '-', 0, 0, '-', 0, 0, 'T', 0, 0, ':', 0, 0);
+			const __m128i spaces = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 0, 0, ' ', 0, 0, 0, 0, 0);
+
+			const __m128i is_separator = _mm_andnot_si128(digit_lanes, _mm_or_si128(_mm_cmpeq_epi8(text, separators), _mm_cmpeq_epi8(text, spaces)));
+
+			if (_mm_movemask_epi8(_mm_or_si128(_mm_and_si128(is_digit, digit_lanes), is_separator)) != 0xFFFF)
+				return false;
+
+#if ___ssse3___
+			/* gather the 12 digits into pairs and let maddubs compute 10 * high + low for each of them */
+			const __m128i packed = _mm_shuffle_epi8(digits, _mm_setr_epi8(0, 1, 2, 3, 5, 6, 8, 9, 11, 12, 14, 15, -1, -1, -1, -1));
+			const __m128i pairs = _mm_maddubs_epi16(packed, _mm_setr_epi8(10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 10, 1, 0, 0, 0, 0));
+
+			f.y = _mm_extract_epi16(pairs, 0) * 100 + _mm_extract_epi16(pairs, 1);
+			f.m = static_cast<unsigned int>(_mm_extract_epi16(pairs, 2));
+			f.d = static_cast<unsigned int>(_mm_extract_epi16(pairs, 3));
+			f.h = static_cast<unsigned int>(_mm_extract_epi16(pairs, 4));
+			f.mi = static_cast<unsigned int>(_mm_extract_epi16(pairs, 5));
+#else
+			f.y = (p[0] - '0') * 1000 + (p[1] - '0') * 100 + (p[2] - '0') * 10 + (p[3] - '0');
+			f.m = static_cast<unsigned int>((p[5] - '0') * 10 + (p[6] - '0'));
+			f.d = static_cast<unsigned int>((p[8] - '0') * 10 + (p[9] - '0'));
+			f.h = static_cast<unsigned int>((p[11] - '0') * 10 + (p[12] - '0'));
+			f.mi = static_cast<unsigned int>((p[14] - '0') * 10 + (p[15] - '0'));
+#endif
+			return true;
+#else
+			(void)p;
+			(void)f;
+
+			return false;
+#endif
+		}
+
+		inline std::from_chars_result parse_iso8601(const char* first, const char* last, iso_fields& f) noexcept
+		{
+			const std::errc invalid = std::errc::invalid_argument;
+
+			const char* p = first;
+			const char* year_at = first;
+			const char* month_at = nullptr;
+			const char* hour_at = nullptr;
+			bool has_time = false;
+
+			f.h = f.mi = f.s = 0;
+			f.fraction = 0;
+			f.offset = 0;
+
+			if ((last - first >= 16) && parse_iso_head_simd(first, f))
+			{
+				month_at = first + 5;
+				hour_at = first + 11;
+				p = first + 16;
+				has_time = true;
+			}
+
+			else
+			{
+				/* expanded years carry a sign and at least four digits */
+				const bool sign = (p < last) && ((*p == '+') || (*p == '-'));
+				const bool negative = sign && (*p == '-');
+
+				if (sign)
+					++p;
+
+				year_at = p;
+				std::uint64_t y = 0;
+
+				while ((p < last) && (static_cast<unsigned int>(static_cast<unsigned char>(*p) - '0') <= 9) && (p - year_at < 18))
+					y = y * 10 + static_cast<unsigned int>(*p++ - '0');
+
+				if ((p - year_at < 4) || (!sign && (p - year_at != 4)))
+					return std::from_chars_result{ (p - year_at < 4) ? p : year_at + 4, invalid };
+
+				f.y = negative ? -static_cast<std::int64_t>(y) : static_cast<std::int64_t>(y);
+
+				if ((p == last) || (*p != '-'))
+					return std::from_chars_result{ p, invalid };
+
+				month_at = ++p;
+
+				if (!read_digits(p, last, 2, f.m))
+					return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+				p += 2;
+
+				if ((p == last) || (*p != '-'))
+					return std::from_chars_result{ p, invalid };
+
+				if (!read_digits(++p, last, 2, f.d))
+					return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+				p += 2;
+
+				if ((p < last) && ((*p == 'T') || (*p == 't') || (*p == ' ')) && (last - p > 1) && (static_cast<unsigned int>(static_cast<unsigned char>(p[1]) - '0') <= 9))
+				{
+					hour_at = ++p;
+
+					if (!read_digits(p, last, 2, f.h))
+						return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+					p += 2;
+
+					if ((p == last) || (*p != ':'))
+						return std::from_chars_result{ p, invalid };
+
+					if (!read_digits(++p, last, 2, f.mi))
+						return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+					p += 2;
+					has_time = true;
+				}
+			}
+
+			if ((f.m < 1) || (f.m > 12))
+				return std::from_chars_result{ month_at, invalid };
+
+			if ((f.d < 1) || (f.d > days_in_month(f.y, f.m)))
+				return std::from_chars_result{ month_at + 3, invalid };
+
+			if (!fits_ticks(f.y, f.m, f.d))
+				return std::from_chars_result{ year_at, std::errc::result_out_of_range };
+
+			if (!has_time)
+				return std::from_chars_result{ p, std::errc() };
+
+			if (f.h > 23)
+				return std::from_chars_result{ hour_at, invalid };
+
+			if (f.mi > 59)
+				return std::from_chars_result{ hour_at + 3, invalid };
+
+			if ((p < last) && (*p == ':'))
+			{
+				if (!read_digits(++p, last, 2, f.s))
+					return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+				if (f.s > 59)
+					return std::from_chars_result{ p, invalid };
+
+				p += 2;
+
+				if ((p < last) && ((*p == '.') || (*p == ',')))
+				{
+					const char* const fraction_at = ++p;
+
+					while ((p < last) && (static_cast<unsigned int>(static_cast<unsigned char>(*p) - '0') <= 9))
+					{
+						if (p - fraction_at < 7)
+							f.fraction = f.fraction * 10 + (*p - '0');
+
+						++p;
+					}
+
+					if (p == fraction_at)
+						return std::from_chars_result{ p, invalid };
+
+					if (p - fraction_at < 7)
+						f.fraction *= powers_of_ten[7 - (p - fraction_at)];
+				}
+			}
+
+			if ((p < last) && ((*p == 'Z') || (*p == 'z')))
+				return std::from_chars_result{ p + 1, std::errc() };
+
+			if ((p < last) && ((*p == '+') || (*p == '-')))
+			{
+				const std::int64_t sign = (*p == '+') ? 1 : -1;
+				const char* const offset_at = p++;
+				unsigned int oh = 0, om = 0;
+
+				if (!read_digits(p, last, 2, oh))
+					return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+				p += 2;
+
+				if ((p < last) && (*p == ':'))
+				{
+					if (!read_digits(++p, last, 2, om))
+						return std::from_chars_result{ first_non_digit(p, last, 2), invalid };
+
+					p += 2;
+				}
+
+				else if (read_digits(p, last, 2, om))
+					p += 2;
+
+				if ((oh > 23) || (om > 59))
+					return std::from_chars_result{ offset_at, invalid };
+
+				f.offset = sign * (oh * ticks_per_hour + om * ticks_per_minute);
+			}
+
+			return std::from_chars_result{ p, std::errc() };
+		}
+	}
+
+	inline std::from_chars_result from_chars(const char* first, const char* last, timestamp& value) noexcept
+	{
+		detail::iso_fields f;
+
+		const std::from_chars_result result = detail::parse_iso8601(first, last, f);
+
+		if (result.ec == std::errc())
+		{
+			value = timestamp(days_from_civil(f.y, f.m, f.d) * ticks_per_day + f.h * ticks_per_hour + f.mi * ticks_per_minute
+				+ f.s * ticks_per_second + f.fraction - f.offset);
+		}
+
+		return result;
+	}
+
+	inline std::from_chars_result from_chars(const char* first, const char* last, date_time& value)
+	{
+		timestamp _timestamp;
+
+		const std::from_chars_result result = from_chars(first, last, _timestamp);
+
+		if (result.ec == std::errc())
+			value = _timestamp.to_date_time();
+
+		return result;
+	}
+
+#if ___cpp20___
+	namespace detail
+	{
+		/* Reads the text of a literal while compiling, every throw turns into a compile error pointing at its message */
+		struct literal_reader
+		{
+			const char* text;
+			std::size_t size;
+			std::size_t position;
+
+			___nodiscard___ consteval bool done() const noexcept
+			{
+				return position == size;
+			}
+
+			consteval bool skip(char c) noexcept
+			{
+				if ((position == size) || (text[position] != c))
+					return false;
+
+				++position;
+
+				return true;
+			}
+
+			/* Between minimum and maximum digits */
+			consteval std::int64_t number(std::size_t minimum, std::size_t maximum, const char* error)
+			{
+				std::int64_t value = 0;
+				std::size_t count = 0;
+
+				while ((position != size) && (count < maximum) && (text[position] >= '0') && (text[position] <= '9'))
+				{
+					value = value * 10 + (text[position++] - '0');
+					++count;
+				}
+
+				if (count < minimum)
+					throw basic_error(error);
+
+				return value;
+			}
+
+			/* [-]YYYY-MM-DD with astronomical years, so 0000 is 1 BCE */
+			consteval date read_date()
+			{
+				const bool negative = skip('-');
+				const std::int64_t y = negative ? -number(4, 9, "Invalid year in date literal!") : number(4, 9, "Invalid year in date literal!");
+
+				if (!skip('-'))
+					throw basic_error("Invalid date literal!");
+
+				const unsigned int m = static_cast<unsigned int>(number(2, 2, "Invalid month in date literal!"));
+
+				if (!skip('-'))
+					throw basic_error("Invalid date literal!");
+
+				const unsigned int d = static_cast<unsigned int>(number(2, 2, "Invalid day in date literal!"));
+
+				if ((m < 1) || (m > 12))
+					throw basic_error("Invalid month in date literal!");
+
+				if ((d < 1) || (d > days_in_month(y, m)))
+					throw basic_error("Invalid day in date literal!");
+
+				const year Y = (y > 0) ? year(static_cast<std::uint64_t>(y), false) : year(static_cast<std::uint64_t>(1 - y), true);
+
+				return date(Y, month(static_cast<unsigned short int>(m)), day(weekday_from_days(days_from_civil(y, m, d)), static_cast<unsigned short int>(d)));
+			}
+
+			/* HH:MM[:SS[.f[f[f]]]] */
+			consteval time read_time()
+			{
+				const std::int64_t h = number(2, 2, "Invalid hours in time literal!");
+
+				if (!skip(':'))
+					throw basic_error("Invalid time literal!");
+
+				const std::int64_t mi = number(2, 2, "Invalid minutes in time literal!");
+				std::int64_t s = 0, ms = 0;
+
+				if (skip(':'))
+				{
+					s = number(2, 2, "Invalid seconds in time literal!");
+
+					if (skip('.'))
+					{
+						const std::size_t start = position;
+
+						ms = number(1, 3, "Invalid fraction in time literal!");
+
+						for (std::size_t i = position - start; i < 3; ++i)
+							ms *= 10;
+					}
+				}
+
+				if (h > 23)
+					throw basic_error("Invalid hours in time literal!");
+
+				if (mi > 59)
+					throw basic_error("Invalid minutes in time literal!");
+
+				if (s > 59)
+					throw basic_error("Invalid seconds in time literal!");
+
+				return time(static_cast<unsigned short int>(h), static_cast<unsigned short int>(mi), static_cast<unsigned short int>(s), static_cast<unsigned short int>(ms));
+			}
+		};
+	}
+
+	/* Checked while compiling, a literal that is not a valid date or time does not compile:
+
+		constinit dt0::date cutover = "2024-03-01"_date;
+		constexpr dt0::time open = "09:30"_time;
+		constexpr dt0::date_time deadline = "2024-03-01T12:30:00.250"_date_time; */
+	inline namespace literals
+	{
+		___nodiscard___ consteval date operator""_date(const char* text, std::size_t size)
+		{
+			detail::literal_reader reader{ text, size, 0 };
+
+			const date value = reader.read_date();
+
+			if (!reader.done())
+				throw basic_error("Invalid date literal!");
+
+			return value;
+		}
+
+		___nodiscard___ consteval time operator""_time(const char* text, std::size_t size)
+		{
+			detail::literal_reader reader{ text, size, 0 };
+
+			const time value = reader.read_time();
+
+			if (!reader.done())
+				throw basic_error("Invalid time literal!");
+
+			return value;
+		}
+
+		/* The date and time are separated by a T or a space */
+		___nodiscard___ consteval date_time operator""_date_time(const char* text, std::size_t size)
+		{
+			detail::literal_reader reader{ text, size, 0 };
+
+			const date D = reader.read_date();
+
+			if (!reader.skip('T') && !reader.skip(' '))
+				throw basic_error("Invalid date time literal!");
+
+			const time T = reader.read_time();
+
+			if (!reader.done())
+				throw basic_error("Invalid date time literal!");
+
+			return date_time(D, T);
+		}
+	}
+#endif
+
+	namespace detail
+	{
+		/* The splitmix64 finalizer, every key bit reaches every hash bit so neighbouring instants spread over all buckets */
+		___nodiscard___ ___constexpr14___ std::uint64_t mix64(std::uint64_t x) noexcept
+		{
+			x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+			x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+
+			return x ^ (x >> 31);
+		}
+	}
+}
+
+namespace std
+{
+	template <class Period>
+	struct hash<dt0::duration<Period>>
+	{
+		std::size_t operator() (const dt0::duration<Period>& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.count())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::time>
+	{
+		std::size_t operator() (const dt0::time& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.order_key())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::day>
+	{
+		std::size_t operator() (const dt0::day& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.order_key())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::month>
+	{
+		std::size_t operator() (const dt0::month& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.order_key())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::year>
+	{
+		std::size_t operator() (const dt0::year& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.order_key())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::date>
+	{
+		std::size_t operator() (const dt0::date& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.order_key())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::timestamp>
+	{
+		std::size_t operator() (const dt0::timestamp& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(static_cast<std::uint64_t>(value.order_key())));
+		}
+	};
+
+	template <>
+	struct hash<dt0::date_time>
+	{
+		std::size_t operator() (const dt0::date_time& value) const noexcept
+		{
+			return static_cast<std::size_t>(dt0::detail::mix64(dt0::detail::mix64(static_cast<std::uint64_t>(value.get_date().order_key())) ^ value.get_time().order_key()));
+		}
 	};
 }
 
@@ -0,0 +1,1007 @@
+#ifndef DATE_TIME_FORMAT_HPP
+#define DATE_TIME_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <system_error>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+
+/* The date_time_format class compiles a strftime style pattern once into a flat list of emit operations, formatting a value
+is then a single pass over that list with no pattern scanning. The constructor is constexpr, so a constexpr format object
+(or the "..."_format literal under C++20) has its pattern checked while compiling:
+
+	constexpr dt0::date_time_format iso("%Y-%m-%d %H:%M:%S.%f");
+
+	%Y	year, four digits from 0000 to 9999 and a sign with at least four digits outside of that
+	%y	year of the century, two digits
+	%m	month, two digits
+	%d	day of the month, two digits
+	%e	day of the month, space padded
+	%j	day of the year, three digits
+	%H	hour, two digits
+	%I	hour on a 12 hour clock, two digits
+	%p	AM or PM
+	%M	minute, two digits
+	%S	second, two digits
+	%f	milliseconds, three digits, %1f to %7f give that many digits of the second (down to the tick)
+	%a	week day name, abbreviated
+	%A	week day name
+	%b	month name, abbreviated
+	%B	month name
+	%u	week day, 1 is Monday and 7 is Sunday
+	%w	week day, 0 is Sunday and 6 is Saturday
+	%z	offset from UTC as +hhmm, always +0000 when formatting
+	%F	%Y-%m-%d
+	%T	%H:%M:%S
+	%%	a percent sign
+
+Patterns without full names also get a pre-rendered layout with every field at a fixed position, so values with four digit
+years are written as one copy of the layout with the digits patched in.
+
+The same compiled pattern parses text through from_chars, one pass over the operations without allocating:
+
+	%Y			an optional sign and 1 to 4 digits, up to 9 after a sign
+	%y			1 or 2 digits, 69 to 99 are 1969 to 1999 and 00 to 68 are 2000 to 2068
+	%m %d %H %I %M %S	1 or 2 digits, %e may start with a space
+	%j			1 to 3 digits, used when the pattern has no month and day
+	%f			1 up to its number of digits
+	%a %A %b %B		any day or month name or abbreviation the day and month classes know, in any case
+	%p			AM or PM in any case
+	%u %w			one digit
+	%z			Z, +hh, +hhmm or +hh:mm, the result is converted to UTC
+
+A space in the pattern matches any run of white space (including none), other literals match themselves. Fields the pattern
+lacks default to 1970-01-01 00:00:00, week days are checked against the date. Like std::from_chars the parse stops after the
+pattern and on failure ptr is the first offending byte. */
+
+namespace dt0
+{
+	namespace detail
+	{
+		enum class format_field : unsigned char
+		{
+			literal,
+			year,
+			year_of_century,
+			month,
+			day,
+			day_space_padded,
+			day_of_year,
+			hour,
+			hour12,
+			am_pm,
+			minute,
+			second,
+			fraction,
+			weekday_name,
+			weekday_abbreviation,
+			month_name,
+			month_abbreviation,
+			iso_weekday,
+			weekday,
+			utc_offset
+		};
+
+		/* width is the literal length or the fraction digits, offset the literal's start in the text and position the
+		operation's place in the fixed layout */
+		struct format_op
+		{
+			format_field field;
+			unsigned char width;
+			unsigned char offset;
+			unsigned short int position;
+		};
+
+		/* A two digit field of the fixed layout, value picks year / 100, year % 100, month, day, hour, hour12, minute or second */
+		struct format_pair
+		{
+			unsigned short int position;
+			unsigned char value;
+		};
+
+		/* What the emit operations read, days is only filled in when a pattern asks for the week day */
+		struct format_fields
+		{
+			std::int64_t y;
+			unsigned int m;
+			unsigned int d;
+			unsigned int h;
+			unsigned int mi;
+			unsigned int s;
+			std::uint32_t fraction;
+			std::int64_t days;
+		};
+
+		/* What a parse collects, the positions are blamed when the fields do not make a valid date */
+		struct parse_fields
+		{
+			std::int64_t y;
+			unsigned int m, d, h, mi, s;
+			unsigned int day_of_year;
+			unsigned int week_index;
+			int pm;
+			std::uint32_t fraction;
+			std::int64_t offset;
+			const char* year_at;
+			const char* day_at;
+			const char* week_index_at;
+		};
+
+		/* Reads 1 to count digits, returns the byte after them or nullptr when p holds no digit */
+		inline const char* read_number(const char* p, const char* last, std::ptrdiff_t count, unsigned int& value) noexcept
+		{
+			const char* const first = p;
+
+			value = 0;
+
+			while ((p < last) && (p - first < count) && (static_cast<unsigned int>(static_cast<unsigned char>(*p) - '0') <= 9))
+				value = value * 10 + static_cast<unsigned int>(*p++ - '0');
+
+			return (p == first) ? nullptr : p;
+		}
+
+		/* Reads a run of letters through a name table, returns the byte after it or nullptr for an unknown name */
+		inline const char* read_name(const char* p, const char* last, const name_table& table, unsigned int& index) noexcept
+		{
+			const char* const first = p;
+
+			while ((p < last) && (p - first < 10) && (static_cast<unsigned int>((static_cast<unsigned char>(*p) | 0x20) - 'a') < 26))
+				++p;
+
+			index = lookup_name(table, std::string_view(first, static_cast<std::size_t>(p - first)));
+
+			return (index == 0) ? nullptr : p;
+		}
+	}
+
+	class date_time_format
+	{
+	public:
+		static ___constexpr___ std::size_t max_ops = 48;
+		static ___constexpr___ std::size_t max_text = 64;
+
+		/* Enough for any value of any pattern */
+		static ___constexpr___ std::ptrdiff_t max_chars = static_cast<std::ptrdiff_t>(max_ops * 20 + max_text);
+
+		explicit ___constexpr14___ date_time_format(std::string_view pattern) :
+			_ops{}, _patches{}, _pairs{}, _text{}, _layout{}, _literal_mask{}, _count(0), _patch_count(0), _pair_count(0), _text_size(0), _layout_size(0), _max_size(0),
+			_needs_days(false), _fixed(true), _parse_fixed(false), _has_century(false), _has_hour12(false), _has_month_day(false)
+		{
+			for (std::size_t i = 0; i < pattern.size(); ++i)
+			{
+				if (pattern[i] != '%')
+				{
+					_add_literal(pattern[i]);
+					continue;
+				}
+
+				if (++i == pattern.size())
+					throw basic_error("Invalid format specifier!");
+
+				unsigned char digits = 0;
+
+				if ((pattern[i] >= '1') && (pattern[i] <= '7'))
+				{
+					digits = static_cast<unsigned char>(pattern[i] - '0');
+
+					if ((++i == pattern.size()) || (pattern[i] != 'f'))
+						throw basic_error("Invalid format specifier!");
+				}
+
+				switch (pattern[i])
+				{
+				case 'Y': _add(detail::format_field::year, 0, 20); break;
+				case 'y': _add(detail::format_field::year_of_century, 0, 2); break;
+				case 'm': _add(detail::format_field::month, 0, 2); break;
+				case 'd': _add(detail::format_field::day, 0, 2); break;
+				case 'e': _add(detail::format_field::day_space_padded, 0, 2); break;
+				case 'j': _add(detail::format_field::day_of_year, 0, 3); break;
+				case 'H': _add(detail::format_field::hour, 0, 2); break;
+				case 'I': _add(detail::format_field::hour12, 0, 2); break;
+				case 'p': _add(detail::format_field::am_pm, 0, 2); break;
+				case 'M': _add(detail::format_field::minute, 0, 2); break;
+				case 'S': _add(detail::format_field::second, 0, 2); break;
+				case 'f': _add(detail::format_field::fraction, (digits != 0) ? digits : 3, (digits != 0) ? digits : 3); break;
+				case 'a': _add(detail::format_field::weekday_abbreviation, 0, 3); break;
+				case 'A': _add(detail::format_field::weekday_name, 0, 9); break;
+				case 'b': _add(detail::format_field::month_abbreviation, 0, 3); break;
+				case 'B': _add(detail::format_field::month_name, 0, 9); break;
+				case 'u': _add(detail::format_field::iso_weekday, 0, 1); break;
+				case 'w': _add(detail::format_field::weekday, 0, 1); break;
+				case 'z': _add(detail::format_field::utc_offset, 0, 5); break;
+				case '%': _add_literal('%'); break;
+
+				case 'F':
+					_add(detail::format_field::year, 0, 20);
+					_add_literal('-');
+					_add(detail::format_field::month, 0, 2);
+					_add_literal('-');
+					_add(detail::format_field::day, 0, 2);
+					break;
+
+				case 'T':
+					_add(detail::format_field::hour, 0, 2);
+					_add_literal(':');
+					_add(detail::format_field::minute, 0, 2);
+					_add_literal(':');
+					_add(detail::format_field::second, 0, 2);
+					break;
+
+				default:
+					throw basic_error("Invalid format specifier!");
+				}
+			}
+
+			_prepare_parse();
+		}
+
+		date_time_format(const date_time_format& other) noexcept = default;
+		date_time_format(date_time_format&& other) noexcept = default;
+
+		~date_time_format() noexcept = default;
+
+		date_time_format& operator= (const date_time_format& other) noexcept = default;
+		date_time_format& operator= (date_time_format&& other) noexcept = default;
+
+		/* The longest output of a single value, a bulk call needs this plus the terminator per value */
+		___nodiscard___ ___constexpr___ std::size_t max_size() const noexcept
+		{
+			return _max_size;
+		}
+
+		std::to_chars_result to_chars(char* first, char* last, const date_time& value) const noexcept
+		{
+			return _finish(first, last, _fields(value));
+		}
+
+		std::to_chars_result to_chars(char* first, char* last, timestamp value) const noexcept
+		{
+			return _finish(first, last, _fields(value.ticks()));
+		}
+
+		___nodiscard___ std::string as_string(const date_time& value) const
+		{
+			char _buffer[max_chars];
+
+			return std::string(_buffer, _write(_buffer, _fields(value)));
+		}
+
+		___nodiscard___ std::string as_string(timestamp value) const
+		{
+			char _buffer[max_chars];
+
+			return std::string(_buffer, _write(_buffer, _fields(value.ticks())));
+		}
+
+		/* Writes every value followed by terminator, out needs count * (max_size() + 1) bytes, returns the end of the output */
+		char* format(const date_time* values, std::size_t count, char* out, char terminator = '\n') const noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out = _write(out, _fields(values[i]));
+				*out++ = terminator;
+			}
+
+			return out;
+		}
+
+		char* format(const timestamp* values, std::size_t count, char* out, char terminator = '\n') const noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out = _write(out, _fields(values[i].ticks()));
+				*out++ = terminator;
+			}
+
+			return out;
+		}
+
+		char* format(const std::int64_t* ticks, std::size_t count, char* out, char terminator = '\n') const noexcept
+		{
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				out = _write(out, _fields(ticks[i]));
+				*out++ = terminator;
+			}
+
+			return out;
+		}
+
+		std::from_chars_result from_chars(const char* first, const char* last, std::int64_t& ticks) const noexcept
+		{
+			detail::parse_fields f;
+
+			const std::from_chars_result result = _parse(first, last, f);
+
+			if (result.ec == std::errc())
+			{
+				ticks = days_from_civil(f.y, f.m, f.d) * ticks_per_day + f.h * ticks_per_hour + f.mi * ticks_per_minute
+					+ f.s * ticks_per_second + f.fraction - f.offset;
+			}
+
+			return result;
+		}
+
+		std::from_chars_result from_chars(const char* first, const char* last, timestamp& value) const noexcept
+		{
+			std::int64_t _ticks = 0;
+
+			const std::from_chars_result result = from_chars(first, last, _ticks);
+
+			if (result.ec == std::errc())
+				value = timestamp(_ticks);
+
+			return result;
+		}
+
+		std::from_chars_result from_chars(const char* first, const char* last, date_time& value) const
+		{
+			std::int64_t _ticks = 0;
+
+			const std::from_chars_result result = from_chars(first, last, _ticks);
+
+			if (result.ec == std::errc())
+				value = date_time::from_ticks(_ticks);
+
+			return result;
+		}
+
+	private:
+		static ___constexpr___ std::size_t max_layout = max_ops * 7 + max_text;
+
+		/* Width in the fixed layout, where %Y is always four digits, 0 for the names that vary in length */
+		___nodiscard___ static ___constexpr14___ std::size_t _fixed_width(detail::format_field field, unsigned char width) noexcept
+		{
+			switch (field)
+			{
+			case detail::format_field::literal:
+			case detail::format_field::fraction:
+				return width;
+
+			case detail::format_field::year:
+				return 4;
+
+			case detail::format_field::day_of_year:
+			case detail::format_field::weekday_abbreviation:
+			case detail::format_field::month_abbreviation:
+				return 3;
+
+			case detail::format_field::iso_weekday:
+			case detail::format_field::weekday:
+				return 1;
+
+			case detail::format_field::utc_offset:
+				return 5;
+
+			case detail::format_field::weekday_name:
+			case detail::format_field::month_name:
+				return 0;
+
+			default:
+				return 2;
+			}
+		}
+
+		___constexpr14___ void _add(detail::format_field field, unsigned char width, std::size_t size)
+		{
+			if (_count == max_ops)
+				throw basic_error("Format pattern too long!");
+
+			const detail::format_op op{ field, width, 0, static_cast<unsigned short int>(_layout_size) };
+
+			_ops[_count++] = op;
+			_max_size += size;
+
+			if ((field == detail::format_field::weekday_name) || (field == detail::format_field::weekday_abbreviation)
+				|| (field == detail::format_field::iso_weekday) || (field == detail::format_field::weekday))
+				_needs_days = true;
+
+			if ((field == detail::format_field::weekday_name) || (field == detail::format_field::month_name))
+				_fixed = false;
+
+			if ((field == detail::format_field::literal) || !_fixed)
+				return;
+
+			switch (field)
+			{
+			case detail::format_field::year:
+				_pairs[_pair_count++] = detail::format_pair{ op.position, 0 };
+				_pairs[_pair_count++] = detail::format_pair{ static_cast<unsigned short int>(op.position + 2), 1 };
+				break;
+
+			case detail::format_field::year_of_century: _pairs[_pair_count++] = detail::format_pair{ op.position, 1 }; break;
+			case detail::format_field::month: _pairs[_pair_count++] = detail::format_pair{ op.position, 2 }; break;
+			case detail::format_field::day: _pairs[_pair_count++] = detail::format_pair{ op.position, 3 }; break;
+			case detail::format_field::hour: _pairs[_pair_count++] = detail::format_pair{ op.position, 4 }; break;
+			case detail::format_field::hour12: _pairs[_pair_count++] = detail::format_pair{ op.position, 5 }; break;
+			case detail::format_field::minute: _pairs[_pair_count++] = detail::format_pair{ op.position, 6 }; break;
+			case detail::format_field::second: _pairs[_pair_count++] = detail::format_pair{ op.position, 7 }; break;
+
+			default:
+				_patches[_patch_count++] = op;
+				break;
+			}
+
+			_layout_size += _fixed_width(field, width);
+		}
+
+		/* The layout parse reads each field once, so it is left out when a pattern sets a field twice (like %H and %I) */
+		___constexpr14___ void _prepare_parse() noexcept
+		{
+			unsigned int seen = 0;
+			bool repeated = false;
+
+			for (std::size_t i = 0; i < _count; ++i)
+			{
+				const detail::format_op& op = _ops[i];
+				unsigned int group = 0;
+
+				switch (op.field)
+				{
+				case detail::format_field::literal:
+					for (std::size_t j = op.position; j < op.position + op.width; ++j)
+						_literal_mask[j] = static_cast<char>(0xFF);
+
+					continue;
+
+				case detail::format_field::year:
+				case detail::format_field::year_of_century:
+					_has_century = _has_century || (op.field == detail::format_field::year);
+					group = 1;
+					break;
+
+				case detail::format_field::month:
+				case detail::format_field::month_name:
+				case detail::format_field::month_abbreviation:
+					_has_month_day = true;
+					group = 2;
+					break;
+
+				case detail::format_field::day:
+				case detail::format_field::day_space_padded:
+					_has_month_day = true;
+					group = 4;
+					break;
+
+				case detail::format_field::hour:
+				case detail::format_field::hour12:
+					_has_hour12 = _has_hour12 || (op.field == detail::format_field::hour12);
+					group = 8;
+					break;
+
+				case detail::format_field::minute: group = 16; break;
+				case detail::format_field::second: group = 32; break;
+				case detail::format_field::fraction: group = 64; break;
+				case detail::format_field::day_of_year: group = 128; break;
+				case detail::format_field::am_pm: group = 256; break;
+				case detail::format_field::utc_offset: group = 512; break;
+				default: group = 1024; break;
+				}
+
+				repeated = repeated || ((seen & group) != 0);
+				seen |= group;
+			}
+
+			_parse_fixed = _fixed && !repeated;
+		}
+
+		/* Neighbouring literal characters share one operation, they are also laid into the fixed layout */
+		___constexpr14___ void _add_literal(char c)
+		{
+			if (_text_size == max_text)
+				throw basic_error("Format pattern too long!");
+
+			if ((_count != 0) && (_ops[_count - 1].field == detail::format_field::literal))
+				++_ops[_count - 1].width;
+
+			else
+			{
+				_add(detail::format_field::literal, 1, 0);
+				_ops[_count - 1].offset = static_cast<unsigned char>(_text_size);
+			}
+
+			_text[_text_size++] = c;
+			_layout[_layout_size++] = c;
+			++_max_size;
+		}
+
+		___nodiscard___ detail::format_fields _fields(const date_time& value) const noexcept
+		{
+			const date D = value.get_date();
+			const time T = value.get_time();
+
+			return detail::format_fields{ D.get_year().astronomical(), D.get_month().index(), D.get_day().month_index(),
+				T.hours(), T.minutes(), T.seconds(), static_cast<std::uint32_t>(T.milliseconds()) * static_cast<std::uint32_t>(ticks_per_millisecond),
+				_needs_days ? D.days_since_epoch() : 0 };
+		}
+
+		___nodiscard___ detail::format_fields _fields(std::int64_t ticks) const noexcept
+		{
+			const std::int64_t days = days_from_ticks(ticks);
+			const civil_date C = civil_from_days(days);
+			const std::int64_t tod = ticks - days * ticks_per_day;
+			const unsigned int seconds = static_cast<unsigned int>(tod / ticks_per_second);
+
+			return detail::format_fields{ C.y, C.m, C.d, seconds / 3600, (seconds / 60) % 60, seconds % 60,
+				static_cast<std::uint32_t>(tod % ticks_per_second), days };
+		}
+
+		/* A value with a four digit year in a pattern without full names is the layout with the fields patched in,
+		anything else goes through the operations one by one */
+		char* _write(char* p, const detail::format_fields& f) const noexcept
+		{
+			if (_fixed && (f.y >= 0) && (f.y <= 9999))
+			{
+				const unsigned int _values[8] = { static_cast<unsigned int>(f.y / 100), static_cast<unsigned int>(f.y % 100), f.m, f.d, f.h, ((f.h + 11) % 12) + 1, f.mi, f.s };
+
+				/* Stores through p may alias the members, so the sizes are read once */
+				const std::size_t layout_size = _layout_size;
+				const std::size_t pair_count = _pair_count;
+				const std::size_t patch_count = _patch_count;
+
+				std::memcpy(p, _layout, layout_size);
+
+				for (std::size_t i = 0; i < pair_count; ++i)
+					std::memcpy(p + _pairs[i].position, detail::digit_pairs + 2 * _values[_pairs[i].value], 2);
+
+				for (std::size_t i = 0; i < patch_count; ++i)
+					_write_field(p + _patches[i].position, _patches[i], f);
+
+				return p + layout_size;
+			}
+
+			for (std::size_t i = 0; i < _count; ++i)
+				p = _write_field(p, _ops[i], f);
+
+			return p;
+		}
+
+		char* _write_field(char* p, const detail::format_op& op, const detail::format_fields& f) const noexcept
+		{
+			switch (op.field)
+			{
+			case detail::format_field::literal:
+				std::memcpy(p, _text + op.offset, op.width);
+				p += op.width;
+				break;
+
+			case detail::format_field::year:
+				p = detail::write_year(p, f.y);
+				break;
+
+			case detail::format_field::year_of_century:
+				p = detail::write_2digits(p, static_cast<unsigned int>(((f.y % 100) + 100) % 100));
+				break;
+
+			case detail::format_field::month:
+				p = detail::write_2digits(p, f.m);
+				break;
+
+			case detail::format_field::day:
+				p = detail::write_2digits(p, f.d);
+				break;
+
+			case detail::format_field::day_space_padded:
+				p = detail::write_2digits(p, f.d);
+
+				if (f.d < 10)
+					p[-2] = ' ';
+
+				break;
+
+			case detail::format_field::day_of_year:
+				p = detail::write_fixed(p, dt0::day_of_year(f.y, f.m, f.d), 3);
+				break;
+
+			case detail::format_field::hour:
+				p = detail::write_2digits(p, f.h);
+				break;
+
+			case detail::format_field::hour12:
+				p = detail::write_2digits(p, ((f.h + 11) % 12) + 1);
+				break;
+
+			case detail::format_field::am_pm:
+				std::memcpy(p, (f.h < 12) ? "AM" : "PM", 2);
+				p += 2;
+				break;
+
+			case detail::format_field::minute:
+				p = detail::write_2digits(p, f.mi);
+				break;
+
+			case detail::format_field::second:
+				p = detail::write_2digits(p, f.s);
+				break;
+
+			case detail::format_field::fraction:
+				p = detail::write_fixed(p, f.fraction / detail::powers_of_ten[7 - op.width], op.width);
+				break;
+
+			case detail::format_field::weekday_name:
+				p = _write_name(p, detail::day_display_names[weekday_from_days(f.days)]);
+				break;
+
+			case detail::format_field::weekday_abbreviation:
+				p = _write_name(p, detail::day_display_names[weekday_from_days(f.days)].substr(0, 3));
+				break;
+
+			case detail::format_field::month_name:
+				p = _write_name(p, detail::month_display_names[f.m]);
+				break;
+
+			case detail::format_field::month_abbreviation:
+				p = _write_name(p, detail::month_display_names[f.m].substr(0, 3));
+				break;
+
+			case detail::format_field::iso_weekday:
+				*p++ = static_cast<char>('0' + weekday_from_days(f.days));
+				break;
+
+			case detail::format_field::weekday:
+				*p++ = static_cast<char>('0' + weekday_from_days(f.days) % 7);
+				break;
+
+			case detail::format_field::utc_offset:
+				std::memcpy(p, "+0000", 5);
+				p += 5;
+				break;
+			}
+
+			return p;
+		}
+
+		static char* _write_name(char* p, std::string_view name) noexcept
+		{
+			std::memcpy(p, name.data(), name.size());
+
+			return p + name.size();
+		}
+
+		/* The fixed layout is tried first, text that matches it byte for byte (literals and every field at its formatted width)
+		is a masked compare plus a few digit pairs. Anything else, including every error, goes through the operations. */
+		std::from_chars_result _parse(const char* first, const char* last, detail::parse_fields& f) const noexcept
+		{
+			const char* p = first;
+			const char* blame = nullptr;
+
+			if (_parse_fixed && (last - first >= static_cast<std::ptrdiff_t>(_layout_size)) && _parse_layout(first, last, f) && (_resolve(f, blame) == std::errc()))
+				return std::from_chars_result{ first + _layout_size, std::errc() };
+
+			f = detail::parse_fields{ 1970, 1, 1, 0, 0, 0, 0, 0, -1, 0, 0, nullptr, nullptr, nullptr };
+
+			for (std::size_t i = 0; i < _count; ++i)
+			{
+				const std::from_chars_result result = _parse_field(p, last, _ops[i], f);
+
+				if (result.ec != std::errc())
+					return result;
+
+				p = result.ptr;
+			}
+
+			const std::errc ec = _resolve(f, blame);
+
+			return std::from_chars_result{ (ec == std::errc()) ? p : blame, ec };
+		}
+
+		bool _parse_layout(const char* first, const char* last, detail::parse_fields& f) const noexcept
+		{
+			std::size_t i = 0;
+
+			for (; i + 8 <= _layout_size; i += 8)
+			{
+				std::uint64_t text = 0, layout = 0, mask = 0;
+
+				std::memcpy(&text, first + i, 8);
+				std::memcpy(&layout, _layout + i, 8);
+				std::memcpy(&mask, _literal_mask + i, 8);
+
+				if (((text ^ layout) & mask) != 0)
+					return false;
+			}
+
+			for (; i < _layout_size; ++i)
+			{
+				if (((first[i] ^ _layout[i]) & _literal_mask[i]) != 0)
+					return false;
+			}
+
+			unsigned int _values[8] = { 19, 70, 1, 1, 0, 12, 0, 0 };
+
+			for (i = 0; i < _pair_count; ++i)
+			{
+				const unsigned int high = static_cast<unsigned int>(static_cast<unsigned char>(first[_pairs[i].position]) - '0');
+				const unsigned int low = static_cast<unsigned int>(static_cast<unsigned char>(first[_pairs[i].position + 1]) - '0');
+
+				if ((high | low) > 9)
+					return false;
+
+				_values[_pairs[i].value] = high * 10 + low;
+			}
+
+			f = detail::parse_fields{ _has_century ? static_cast<std::int64_t>(_values[0] * 100 + _values[1]) : ((_values[1] < 69) ? (2000 + _values[1]) : (1900 + _values[1])),
+				_values[2], _values[3], _has_hour12 ? _values[5] : _values[4], _values[6], _values[7], 0, 0, -1, 0, 0, nullptr, nullptr, nullptr };
+
+			if ((f.m < 1) || (f.m > 12) || (f.d < 1) || (f.d > 31) || (f.h > 23) || (_has_hour12 && (f.h < 1 || f.h > 12)) || (f.mi > 59) || (f.s > 59))
+				return false;
+
+			for (i = 0; i < _patch_count; ++i)
+			{
+				const char* const at = first + _patches[i].position;
+				const std::from_chars_result result = _parse_field(at, last, _patches[i], f);
+
+				if ((result.ec != std::errc()) || (result.ptr != at + _fixed_width(_patches[i].field, _patches[i].width)))
+					return false;
+			}
+
+			return true;
+		}
+
+		std::from_chars_result _parse_field(const char* p, const char* last, const detail::format_op& op, detail::parse_fields& f) const noexcept
+		{
+			const std::errc invalid = std::errc::invalid_argument;
+			const char* const at = p;
+			unsigned int value = 0;
+
+			switch (op.field)
+			{
+			case detail::format_field::literal:
+				for (std::size_t j = op.offset; j < op.offset + op.width; ++j)
+				{
+					if (_text[j] == ' ')
+					{
+						while ((p < last) && ((*p == ' ') || (static_cast<unsigned int>(*p - '\t') <= '\r' - '\t')))
+							++p;
+					}
+
+					else if ((p < last) && (*p == _text[j]))
+						++p;
+
+					else
+						return std::from_chars_result{ p, invalid };
+				}
+
+				break;
+
+			case detail::format_field::year:
+			{
+				const bool negative = (p < last) && (*p == '-');
+				const bool sign = negative || ((p < last) && (*p == '+'));
+
+				f.year_at = at + (sign ? 1 : 0);
+
+				if ((p = detail::read_number(f.year_at, last, sign ? 9 : 4, value)) == nullptr)
+					return std::from_chars_result{ f.year_at, invalid };
+
+				f.y = negative ? -static_cast<std::int64_t>(value) : static_cast<std::int64_t>(value);
+				break;
+			}
+
+			case detail::format_field::year_of_century:
+				if ((p = detail::read_number(p, last, 2, value)) == nullptr)
+					return std::from_chars_result{ at, invalid };
+
+				f.y = (value < 69) ? (2000 + value) : (1900 + value);
+				break;
+
+			case detail::format_field::month:
+				if (((p = detail::read_number(p, last, 2, f.m)) == nullptr) || (f.m < 1) || (f.m > 12))
+					return std::from_chars_result{ at, invalid };
+				break;
+
+			case detail::format_field::day_space_padded:
+			case detail::format_field::day:
+				if ((op.field == detail::format_field::day_space_padded) && (p < last) && (*p == ' '))
+					++p;
+
+				f.day_at = p;
+
+				if (((p = detail::read_number(p, last, 2, f.d)) == nullptr) || (f.d < 1) || (f.d > 31))
+					return std::from_chars_result{ f.day_at, invalid };
+				break;
+
+			case detail::format_field::day_of_year:
+				if (((p = detail::read_number(p, last, 3, f.day_of_year)) == nullptr) || (f.day_of_year < 1) || (f.day_of_year > 366))
+					return std::from_chars_result{ at, invalid };
+
+				if (f.day_at == nullptr)
+					f.day_at = at;
+
+				break;
+
+			case detail::format_field::hour:
+				if (((p = detail::read_number(p, last, 2, f.h)) == nullptr) || (f.h > 23))
+					return std::from_chars_result{ at, invalid };
+
+				break;
+
+			case detail::format_field::hour12:
+				if (((p = detail::read_number(p, last, 2, f.h)) == nullptr) || (f.h < 1) || (f.h > 12))
+					return std::from_chars_result{ at, invalid };
+
+				break;
+
+			case detail::format_field::am_pm:
+				if ((last - p < 2) || (((p[1] | 0x20) != 'm') || (((p[0] | 0x20) != 'a') && ((p[0] | 0x20) != 'p'))))
+					return std::from_chars_result{ p, invalid };
+
+				f.pm = ((p[0] | 0x20) == 'p') ? 1 : 0;
+				p += 2;
+				break;
+
+			case detail::format_field::minute:
+				if (((p = detail::read_number(p, last, 2, f.mi)) == nullptr) || (f.mi > 59))
+					return std::from_chars_result{ at, invalid };
+
+				break;
+
+			case detail::format_field::second:
+				if (((p = detail::read_number(p, last, 2, f.s)) == nullptr) || (f.s > 59))
+					return std::from_chars_result{ at, invalid };
+
+				break;
+
+			case detail::format_field::fraction:
+				if ((p = detail::read_number(p, last, op.width, value)) == nullptr)
+					return std::from_chars_result{ at, invalid };
+
+				f.fraction = value * detail::powers_of_ten[7 - (p - at)];
+				break;
+
+			case detail::format_field::weekday_name:
+			case detail::format_field::weekday_abbreviation:
+				if ((p = detail::read_name(p, last, detail::day_table, f.week_index)) == nullptr)
+					return std::from_chars_result{ at, invalid };
+
+				f.week_index_at = at;
+				break;
+
+			case detail::format_field::month_name:
+			case detail::format_field::month_abbreviation:
+				if ((p = detail::read_name(p, last, detail::month_table, f.m)) == nullptr)
+					return std::from_chars_result{ at, invalid };
+				break;
+
+			case detail::format_field::iso_weekday:
+			case detail::format_field::weekday:
+				if (((p = detail::read_number(p, last, 1, value)) == nullptr) || (value > 7)
+					|| ((op.field == detail::format_field::iso_weekday) ? (value == 0) : (value == 7)))
+					return std::from_chars_result{ at, invalid };
+
+				f.week_index = (value == 0) ? 7 : value;
+				f.week_index_at = at;
+				break;
+
+			case detail::format_field::utc_offset:
+			{
+				if ((p < last) && ((*p == 'Z') || (*p == 'z')))
+				{
+					++p;
+					break;
+				}
+
+				unsigned int oh = 0, om = 0;
+
+				if ((p == last) || ((*p != '+') && (*p != '-')))
+					return std::from_chars_result{ p, invalid };
+
+				if (!detail::read_digits(p + 1, last, 2, oh))
+					return std::from_chars_result{ detail::first_non_digit(p + 1, last, 2), invalid };
+
+				p += 3;
+
+				if ((p < last) && (*p == ':'))
+				{
+					if (!detail::read_digits(++p, last, 2, om))
+						return std::from_chars_result{ detail::first_non_digit(p, last, 2), invalid };
+
+					p += 2;
+				}
+
+				else if (detail::read_digits(p, last, 2, om))
+					p += 2;
+
+				if ((oh > 23) || (om > 59))
+					return std::from_chars_result{ at, invalid };
+
+				f.offset = ((*at == '+') ? 1 : -1) * (oh * ticks_per_hour + om * ticks_per_minute);
+				break;
+			}
+			}
+
+			return std::from_chars_result{ p, std::errc() };
+		}
+
+		/* Applies AM / PM and the day of the year, then checks the date, blame is set to the first offending byte on failure
+		and dates too far out for ticks are out of range */
+		std::errc _resolve(detail::parse_fields& f, const char*& blame) const noexcept
+		{
+			/* %p only qualifies %I, a 24 hour %H is taken as written */
+			if ((f.pm >= 0) && _has_hour12)
+				f.h = (f.h % 12) + ((f.pm != 0) ? 12 : 0);
+
+			if (!_has_month_day && (f.day_of_year != 0))
+			{
+				if (f.day_of_year > (is_leap_year(f.y) ? 366u : 365u))
+				{
+					blame = f.day_at;
+					return std::errc::invalid_argument;
+				}
+
+				const civil_date C = civil_from_days(days_from_civil(f.y, 1, 1) + f.day_of_year - 1);
+
+				f.m = C.m;
+				f.d = C.d;
+			}
+
+			if (!fits_ticks(f.y, f.m, f.d))
+			{
+				blame = f.year_at;
+				return std::errc::result_out_of_range;
+			}
+
+			if (f.d > days_in_month(f.y, f.m))
+			{
+				blame = f.day_at;
+				return std::errc::invalid_argument;
+			}
+
+			if ((f.week_index != 0) && (weekday_from_days(days_from_civil(f.y, f.m, f.d)) != f.week_index))
+			{
+				blame = f.week_index_at;
+				return std::errc::invalid_argument;
+			}
+
+			return std::errc();
+		}
+
+		std::to_chars_result _finish(char* first, char* last, const detail::format_fields& f) const noexcept
+		{
+			if (last - first >= static_cast<std::ptrdiff_t>(_max_size))
+				return std::to_chars_result{ _write(first, f), std::errc() };
+
+			char _scratch[max_chars];
+
+			return detail::finish_chars(first, last, _scratch, _write(_scratch, f));
+		}
+
+		detail::format_op _ops[max_ops];
+		detail::format_op _patches[max_ops];
+		detail::format_pair _pairs[2 * max_ops];
+		char _text[max_text];
+		char _layout[max_layout];
+		char _literal_mask[max_layout];
+		std::size_t _count;
+		std::size_t _patch_count;
+		std::size_t _pair_count;
+		std::size_t _text_size;
+		std::size_t _layout_size;
+		std::size_t _max_size;
+		bool _needs_days;
+		bool _fixed;
+		bool _parse_fixed;
+		bool _has_century;
+		bool _has_hour12;
+		bool _has_month_day;
+	};
+
+#if ___cpp20___
+	inline namespace literals
+	{
+		/* A format whose pattern is checked while compiling, "%Y%m%d"_format */
+		___nodiscard___ consteval date_time_format operator""_format(const char* text, std::size_t size)
+		{
+			return date_time_format(std::string_view(text, size));
+		}
+	}
+#endif
+}
+
+#endif /* DATE_TIME_FORMAT_HPP */
@@ -0,0 +1,377 @@
+#ifndef FORMATTED_CLOCK_HPP
+#define FORMATTED_CLOCK_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+
+/* The formatted_clock class keeps the current time already written out in the layouts log lines want, so stamping a line
+is a short copy instead of a clock read, a time zone lookup and a formatting pass. A background thread refreshes the texts
+once per granularity (a millisecond or a second are the usual choices) the way clock_service refreshes its ticks.
+
+A refresh within the same day only rewrites the digit pairs that changed, usually the milliseconds and the seconds, and a whole
+text is only redrawn when its day or the UTC offset changes. The texts are published through a sequence lock over atomic words,
+so any number of threads read them without locks and never see a half written text.
+
+	iso8601		2026-10-17 14:03:22.250			local time
+	rfc3339		2026-10-17T12:03:22.250Z		UTC
+	common_log	17/Oct/2026:14:03:22 +0200		local time, the Apache / NCSA access log layout
+	http		Sat, 17 Oct 2026 12:03:22 GMT	UTC, the HTTP Date header (RFC 9110)
+	syslog		Oct 17 14:03:22					local time, the BSD syslog header (RFC 3164) */
+
+namespace dt0
+{
+	enum class time_layout
+	{
+		iso8601,
+		rfc3339,
+		common_log,
+		http,
+		syslog
+	};
+
+	class formatted_clock
+	{
+	public:
+		static ___constexpr___ std::size_t layouts = 5;
+
+		/* Enough for the text of any layout */
+		static ___constexpr___ std::size_t max_chars = 32;
+
+		explicit formatted_clock(std::int64_t granularity = ticks_per_millisecond, clock_source source = clock_source::realtime) :
+			_granularity(granularity), _source(source), _sequence(0), _tick(INT64_MIN), _views{}, _texts{}, _stop(false)
+		{
+			if (granularity < 1)
+				throw basic_error("Invalid clock granularity!");
+
+			for (std::atomic<std::uint64_t>& word : _words)
+				word.store(0, std::memory_order_relaxed);
+
+			for (view& last : _views)
+				last.days = INT64_MIN;
+
+			_refresh();
+
+			_worker = std::thread([this]() { _run(); });
+		}
+
+		formatted_clock(const formatted_clock&) = delete;
+		formatted_clock(formatted_clock&&) = delete;
+		const formatted_clock& operator= (const formatted_clock&) = delete;
+		const formatted_clock& operator= (formatted_clock&&) = delete;
+
+		~formatted_clock() noexcept
+		{
+			{
+				std::lock_guard<std::mutex> _lock(_mutex);
+
+				_stop = true;
+			}
+
+			_wake.notify_one();
+
+			if (_worker.joinable())
+				_worker.join();
+		}
+
+		___nodiscard___ static formatted_clock& instance()
+		{
+			static formatted_clock clock;
+
+			return clock;
+		}
+
+		___nodiscard___ std::int64_t granularity() const noexcept
+		{
+			return _granularity;
+		}
+
+		___nodiscard___ clock_source source() const noexcept
+		{
+			return _source;
+		}
+
+		/* The texts have fixed lengths for years 1000 to 9999 */
+		___nodiscard___ static ___constexpr14___ std::size_t size(time_layout layout) noexcept
+		{
+			return _specs[static_cast<std::size_t>(layout)].length;
+		}
+
+		/* Copies the current text of the layout to out, which needs max_chars bytes, and returns its length. Lock free. */
+		std::size_t read(time_layout layout, char* out) const noexcept
+		{
+			const std::size_t index = static_cast<std::size_t>(layout);
+
+			std::uint64_t _buffer[words_per_text];
+
+			for (;;)
+			{
+				const std::uint64_t before = _sequence.load(std::memory_order_acquire);
+
+				if ((before & 1) == 0)
+				{
+					for (std::size_t w = 0; w < words_per_text; ++w)
+						_buffer[w] = _words[index * words_per_text + w].load(std::memory_order_relaxed);
+
+					std::atomic_thread_fence(std::memory_order_acquire);
+
+					if (_sequence.load(std::memory_order_relaxed) == before)
+						break;
+				}
+
+				std::this_thread::yield();
+			}
+
+			std::memcpy(out, _buffer, _specs[index].length);
+
+			return _specs[index].length;
+		}
+
+		___nodiscard___ std::string as_string(time_layout layout) const
+		{
+			char _buffer[max_chars];
+
+			return std::string(_buffer, read(layout, _buffer));
+		}
+
+	private:
+		static ___constexpr___ std::size_t words_per_text = max_chars / 8;
+
+		/* Where the time digits sit in each layout, millisecond is 0 for layouts without them */
+		struct layout_spec
+		{
+			unsigned char length;
+			unsigned char hour;
+			unsigned char minute;
+			unsigned char second;
+			unsigned char millisecond;
+			bool utc;
+		};
+
+		static ___constexpr___ layout_spec _specs[layouts] =
+		{
+			{ 23, 11, 14, 17, 20, false },
+			{ 24, 11, 14, 17, 20, true },
+			{ 26, 12, 15, 18, 0, false },
+			{ 29, 17, 20, 23, 0, true },
+			{ 15, 7, 10, 13, 0, false }
+		};
+
+		/* The broken down reading of one of the two views (UTC and local) and what it was last drawn with */
+		struct view
+		{
+			std::int64_t days;
+			std::int64_t offset;
+			unsigned int h, mi, s, ms;
+		};
+
+		static view _break_down(std::int64_t ticks, std::int64_t offset) noexcept
+		{
+			const std::int64_t days = days_from_ticks(ticks);
+			const std::int64_t tod = ticks - days * ticks_per_day;
+			const unsigned int seconds = static_cast<unsigned int>(tod / ticks_per_second);
+
+			return view{ days, offset, seconds / 3600, (seconds / 60) % 60, seconds % 60, static_cast<unsigned int>((tod % ticks_per_second) / ticks_per_millisecond) };
+		}
+
+		static char* _write_name(char* p, std::string_view name) noexcept
+		{
+			std::memcpy(p, name.data(), 3);
+
+			return p + 3;
+		}
+
+		static char* _write_milliseconds(char* p, unsigned int ms) noexcept
+		{
+			*p++ = static_cast<char>('0' + ms / 100);
+
+			return detail::write_2digits(p, ms % 100);
+		}
+
+		static char* _write_clock(char* p, const view& v) noexcept
+		{
+			p = detail::write_2digits(p, v.h);
+			*p++ = ':';
+			p = detail::write_2digits(p, v.mi);
+			*p++ = ':';
+
+			return detail::write_2digits(p, v.s);
+		}
+
+		/* Draws a whole text */
+		static void _draw(time_layout layout, char* p, const view& v) noexcept
+		{
+			const civil_date C = civil_from_days(v.days);
+
+			switch (layout)
+			{
+			case time_layout::iso8601:
+			case time_layout::rfc3339:
+				p = detail::write_date(p, C.y, C.m, C.d);
+				*p++ = (layout == time_layout::iso8601) ? ' ' : 'T';
+				p = _write_clock(p, v);
+				*p++ = '.';
+				p = _write_milliseconds(p, v.ms);
+
+				if (layout == time_layout::rfc3339)
+					*p = 'Z';
+
+				break;
+
+			case time_layout::common_log:
+			{
+				const std::int64_t minutes = ((v.offset < 0) ? -v.offset : v.offset) / ticks_per_minute;
+
+				p = detail::write_2digits(p, C.d);
+				*p++ = '/';
+				p = _write_name(p, detail::month_display_names[C.m]);
+				*p++ = '/';
+				p = detail::write_year(p, C.y);
+				*p++ = ':';
+				p = _write_clock(p, v);
+				*p++ = ' ';
+				*p++ = (v.offset < 0) ? '-' : '+';
+				p = detail::write_2digits(p, static_cast<unsigned int>(minutes / 60 % 100));
+				detail::write_2digits(p, static_cast<unsigned int>(minutes % 60));
+				break;
+			}
+
+			case time_layout::http:
+				p = _write_name(p, detail::day_display_names[weekday_from_days(v.days)]);
+				*p++ = ',';
+				*p++ = ' ';
+				p = detail::write_2digits(p, C.d);
+				*p++ = ' ';
+				p = _write_name(p, detail::month_display_names[C.m]);
+				*p++ = ' ';
+				p = detail::write_year(p, C.y);
+				*p++ = ' ';
+				p = _write_clock(p, v);
+				std::memcpy(p, " GMT", 4);
+				break;
+
+			case time_layout::syslog:
+				p = _write_name(p, detail::month_display_names[C.m]);
+				*p++ = ' ';
+				*p++ = (C.d < 10) ? ' ' : static_cast<char>('0' + C.d / 10);
+				*p++ = static_cast<char>('0' + C.d % 10);
+				*p++ = ' ';
+				_write_clock(p, v);
+				break;
+			}
+		}
+
+		void _refresh() noexcept
+		{
+			const std::int64_t tick = floor_div(dt0::utc_ticks(_source), _granularity);
+
+			if (tick == _tick)
+				return;
+
+			_tick = tick;
+
+			/* The texts show the start of the tick, so digits finer than the granularity read as zeros */
+			const std::int64_t utc = tick * _granularity;
+			const std::int64_t offset = local_offset_ticks(utc);
+			const view current[2] = { _break_down(utc + offset, offset), _break_down(utc, 0) };
+
+			for (std::size_t i = 0; i < layouts; ++i)
+			{
+				const layout_spec& spec = _specs[i];
+				const view& now = current[spec.utc ? 1 : 0];
+				view& last = _views[i];
+				char* const text = _texts[i];
+
+				if ((now.days != last.days) || (now.offset != last.offset))
+					_draw(static_cast<time_layout>(i), text, now);
+
+				else
+				{
+					if (now.h != last.h)
+						detail::write_2digits(text + spec.hour, now.h);
+
+					if (now.mi != last.mi)
+						detail::write_2digits(text + spec.minute, now.mi);
+
+					if (now.s != last.s)
+						detail::write_2digits(text + spec.second, now.s);
+
+					if ((spec.millisecond != 0) && (now.ms != last.ms))
+						_write_milliseconds(text + spec.millisecond, now.ms);
+				}
+
+				last = now;
+			}
+
+			_publish();
+		}
+
+		/* Sequence lock writer, only the words whose bytes changed are stored */
+		void _publish() noexcept
+		{
+			const std::uint64_t sequence = _sequence.load(std::memory_order_relaxed);
+
+			_sequence.store(sequence + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+
+			for (std::size_t i = 0; i < layouts; ++i)
+			{
+				for (std::size_t w = 0; w < words_per_text; ++w)
+				{
+					std::uint64_t word;
+
+					std::memcpy(&word, _texts[i] + w * 8, 8);
+
+					if (_words[i * words_per_text + w].load(std::memory_order_relaxed) != word)
+						_words[i * words_per_text + w].store(word, std::memory_order_relaxed);
+				}
+			}
+
+			_sequence.store(sequence + 2, std::memory_order_release);
+		}
+
+		/* Sleeps until the next tick boundary rather than a fixed period, so the texts change within a wake up of the clock */
+		void _run()
+		{
+			std::unique_lock<std::mutex> _lock(_mutex);
+
+			for (;;)
+			{
+				const std::int64_t wait = (_tick + 1) * _granularity - dt0::utc_ticks(_source);
+
+				if (_wake.wait_for(_lock, std::chrono::nanoseconds(((wait > 0) ? wait : 0) * 100), [this]() { return _stop; }))
+					break;
+
+				_refresh();
+			}
+		}
+
+		const std::int64_t _granularity;
+		const clock_source _source;
+
+		std::atomic<std::uint64_t> _sequence;
+		std::atomic<std::uint64_t> _words[layouts * words_per_text];
+
+		/* Only the worker touches these after construction */
+		std::int64_t _tick;
+		view _views[layouts];
+		char _texts[layouts][max_chars];
+
+		bool _stop;
+		std::mutex _mutex;
+		std::condition_variable _wake;
+		std::thread _worker;
+	};
+}
+
+#endif /* FORMATTED_CLOCK_HPP */
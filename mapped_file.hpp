@@ -0,0 +1,152 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <cstddef>
+#include <string>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+
+/* The mapped_file class maps a whole file read only into memory and unmaps it when destroyed.
+An empty file maps to a null data pointer with a size of 0. */
+
+namespace dt0
+{
+	class mapped_file
+	{
+	public:
+		___constexpr20___ mapped_file() noexcept : _data(nullptr), _size(0) {}
+
+		explicit mapped_file(const std::string& path) : _data(nullptr), _size(0)
+		{
+#ifdef _WIN32
+			const HANDLE _file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			if (_file == INVALID_HANDLE_VALUE)
+				throw basic_error("Unable to open file!");
+
+			LARGE_INTEGER _length;
+
+			if (!GetFileSizeEx(_file, &_length))
+			{
+				CloseHandle(_file);
+				throw basic_error("Unable to read file size!");
+			}
+
+			_size = static_cast<std::size_t>(_length.QuadPart);
+
+			if (_size != 0)
+			{
+				const HANDLE _mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+				if (_mapping != nullptr)
+				{
+					_data = static_cast<const unsigned char*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+					CloseHandle(_mapping);
+				}
+			}
+
+			CloseHandle(_file);
+#else
+			const int _file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+			if (_file < 0)
+				throw basic_error("Unable to open file!");
+
+			struct stat _status;
+
+			if (::fstat(_file, &_status) != 0)
+			{
+				::close(_file);
+				throw basic_error("Unable to read file size!");
+			}
+
+			_size = static_cast<std::size_t>(_status.st_size);
+
+			if (_size != 0)
+			{
+				void* const _mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, _file, 0);
+
+				if (_mapping != MAP_FAILED)
+					_data = static_cast<const unsigned char*>(_mapping);
+			}
+
+			::close(_file);
+#endif
+
+			if ((_size != 0) && (_data == nullptr))
+				throw basic_error("Unable to map file!");
+		}
+
+		mapped_file(const mapped_file&) = delete;
+		const mapped_file& operator= (const mapped_file&) = delete;
+
+		mapped_file(mapped_file&& other) noexcept : _data(other._data), _size(other._size)
+		{
+			other._data = nullptr;
+			other._size = 0;
+		}
+
+		const mapped_file& operator= (mapped_file&& other) noexcept
+		{
+			if (this != &other)
+			{
+				_unmap();
+
+				_data = other._data;
+				_size = other._size;
+
+				other._data = nullptr;
+				other._size = 0;
+			}
+
+			return *this;
+		}
+
+		~mapped_file() noexcept
+		{
+			_unmap();
+		}
+
+		___nodiscard___ const unsigned char* data() const noexcept
+		{
+			return _data;
+		}
+
+		___nodiscard___ std::size_t size() const noexcept
+		{
+			return _size;
+		}
+
+		___nodiscard___ bool empty() const noexcept
+		{
+			return _size == 0;
+		}
+
+	private:
+		void _unmap() noexcept
+		{
+			if (_data == nullptr)
+				return;
+
+#ifdef _WIN32
+			UnmapViewOfFile(_data);
+#else
+			::munmap(const_cast<unsigned char*>(_data), _size);
+#endif
+		}
+
+		const unsigned char* _data;
+		std::size_t _size;
+	};
+}
+
+#endif /* MAPPED_FILE_HPP */
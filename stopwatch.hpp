@@ -0,0 +1,283 @@
+#ifndef STOPWATCH_HPP
+#define STOPWATCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include "core_macros.hpp"
+#include "date_time.hpp"
+
+#if ___x86___
+	#ifdef _MSC_VER
+		#include <intrin.h>
+	#else
+		#include <cpuid.h>
+		#include <x86intrin.h>
+	#endif
+#endif
+
+/* The stopwatch class measures elapsed time for profiling, either from CLOCK_MONOTONIC (QueryPerformanceCounter on Windows)
+or from the processor's time stamp counter when it is invariant, which costs a single instruction per reading.
+
+The time stamp counter is calibrated against the monotonic clock the first time tsc_clock::instance() is used, that call
+spins for about 10 ms. A stopwatch asked for the tsc source quietly uses the monotonic clock when the counter is not usable. */
+
+namespace dt0
+{
+	___nodiscard___ inline std::int64_t monotonic_nanoseconds() noexcept
+	{
+#ifdef _WIN32
+		static const std::int64_t frequency = []() noexcept { LARGE_INTEGER f; QueryPerformanceFrequency(&f); return static_cast<std::int64_t>(f.QuadPart); }();
+
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+
+		return (counter.QuadPart / frequency) * 1000000000LL + ((counter.QuadPart % frequency) * 1000000000LL) / frequency;
+#else
+		timespec _timespec;
+
+		clock_gettime(CLOCK_MONOTONIC, &_timespec);
+
+		return static_cast<std::int64_t>(_timespec.tv_sec) * 1000000000LL + _timespec.tv_nsec;
+#endif
+	}
+
+	class tsc_clock
+	{
+	public:
+		explicit tsc_clock(std::chrono::nanoseconds calibration = std::chrono::milliseconds(10)) noexcept : _multiplier(0), _frequency(0.0)
+		{
+			if (!invariant())
+				return;
+
+			std::uint64_t first_cycles = 0, last_cycles = 0;
+			std::int64_t first_time = 0, last_time = 0;
+
+			_sample(first_cycles, first_time);
+
+			do
+			{
+				_sample(last_cycles, last_time);
+			} while (last_time - first_time < calibration.count());
+
+			if ((last_cycles <= first_cycles) || (last_time <= first_time))
+				return;
+
+			_frequency = static_cast<double>(last_cycles - first_cycles) * 1e9 / static_cast<double>(last_time - first_time);
+			_multiplier = static_cast<std::uint64_t>(4294967296.0 * 1e9 / _frequency);
+		}
+
+		tsc_clock(const tsc_clock&) = delete;
+		const tsc_clock& operator= (const tsc_clock&) = delete;
+
+		~tsc_clock() noexcept = default;
+
+		___nodiscard___ static const tsc_clock& instance() noexcept
+		{
+			static const tsc_clock clock;
+
+			return clock;
+		}
+
+		/* CPUID leaf 0x80000007, EDX bit 8: the counter runs at a constant rate through frequency and power state changes */
+		___nodiscard___ static bool invariant() noexcept
+		{
+#if ___x86___
+	#ifdef _MSC_VER
+			int _registers[4] = { 0, 0, 0, 0 };
+
+			__cpuid(_registers, 0x80000000);
+
+			if (static_cast<unsigned int>(_registers[0]) < 0x80000007u)
+				return false;
+
+			__cpuid(_registers, 0x80000007);
+
+			return (_registers[3] & (1 << 8)) != 0;
+	#else
+			unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+			if ((__get_cpuid_max(0x80000000u, nullptr) < 0x80000007u) || !__get_cpuid(0x80000007u, &eax, &ebx, &ecx, &edx))
+				return false;
+
+			return (edx & (1u << 8)) != 0;
+	#endif
+#else
+			return false;
+#endif
+		}
+
+		___nodiscard___ static std::uint64_t read() noexcept
+		{
+#if ___x86___
+			return __rdtsc();
+#else
+			return 0;
+#endif
+		}
+
+		___nodiscard___ bool usable() const noexcept
+		{
+			return _multiplier != 0;
+		}
+
+		/* Counter increments per second */
+		___nodiscard___ double frequency() const noexcept
+		{
+			return _frequency;
+		}
+
+		/* 32.32 fixed point so the conversion is two multiplications and no division */
+		___nodiscard___ std::int64_t to_nanoseconds(std::uint64_t cycles) const noexcept
+		{
+			return static_cast<std::int64_t>((cycles >> 32) * _multiplier + (((cycles & 0xFFFFFFFFu) * _multiplier) >> 32));
+		}
+
+	private:
+		/* Pairs a counter reading with the monotonic clock, keeping the tightest of a few brackets */
+		static void _sample(std::uint64_t& cycles, std::int64_t& nanoseconds) noexcept
+		{
+			std::uint64_t best = ~static_cast<std::uint64_t>(0);
+
+			for (unsigned int i = 0; i < 5; ++i)
+			{
+				const std::uint64_t before = read();
+				const std::int64_t now = monotonic_nanoseconds();
+				const std::uint64_t after = read();
+
+				if (after - before < best)
+				{
+					best = after - before;
+					cycles = before + (after - before) / 2;
+					nanoseconds = now;
+				}
+			}
+		}
+
+		std::uint64_t _multiplier;
+		double _frequency;
+	};
+
+	enum class timer_source
+	{
+		monotonic,
+		tsc
+	};
+
+	class stopwatch
+	{
+	public:
+		/* Starts running right away */
+		explicit stopwatch(timer_source source = timer_source::monotonic) noexcept :
+			_tsc(nullptr), _start(0), _accumulated(0), _running(false)
+		{
+			if (source == timer_source::tsc)
+			{
+				const tsc_clock& clock = tsc_clock::instance();
+
+				if (clock.usable())
+					_tsc = &clock;
+			}
+
+			start();
+		}
+
+		stopwatch(const stopwatch&) noexcept = default;
+		stopwatch& operator= (const stopwatch&) noexcept = default;
+
+		~stopwatch() noexcept = default;
+
+		___nodiscard___ timer_source source() const noexcept
+		{
+			return (_tsc != nullptr) ? timer_source::tsc : timer_source::monotonic;
+		}
+
+		___nodiscard___ bool running() const noexcept
+		{
+			return _running;
+		}
+
+		void start() noexcept
+		{
+			if (_running)
+				return;
+
+			_start = _read();
+			_running = true;
+		}
+
+		void stop() noexcept
+		{
+			if (!_running)
+				return;
+
+			_accumulated += _read() - _start;
+			_running = false;
+		}
+
+		void reset() noexcept
+		{
+			_accumulated = 0;
+			_running = false;
+		}
+
+		void restart() noexcept
+		{
+			_accumulated = 0;
+			_start = _read();
+			_running = true;
+		}
+
+		/* Returns the nanoseconds since the last lap (or start) and keeps running from now */
+		std::int64_t lap() noexcept
+		{
+			const std::uint64_t now = _read();
+			const std::uint64_t raw = _accumulated + (_running ? (now - _start) : 0);
+
+			_accumulated = 0;
+			_start = now;
+			_running = true;
+
+			return _to_nanoseconds(raw);
+		}
+
+		___nodiscard___ std::int64_t elapsed_nanoseconds() const noexcept
+		{
+			return _to_nanoseconds(_accumulated + (_running ? (_read() - _start) : 0));
+		}
+
+		___nodiscard___ std::chrono::nanoseconds elapsed() const noexcept
+		{
+			return std::chrono::nanoseconds(elapsed_nanoseconds());
+		}
+
+		/* In the 100 nanosecond ticks the rest of the library counts in */
+		___nodiscard___ std::int64_t elapsed_ticks() const noexcept
+		{
+			return elapsed_nanoseconds() / 100;
+		}
+
+		/* For display, the hours wrap after a day */
+		___nodiscard___ time elapsed_time() const
+		{
+			return time::from_ticks(elapsed_ticks());
+		}
+
+	private:
+		___nodiscard___ std::uint64_t _read() const noexcept
+		{
+			return (_tsc != nullptr) ? tsc_clock::read() : static_cast<std::uint64_t>(monotonic_nanoseconds());
+		}
+
+		___nodiscard___ std::int64_t _to_nanoseconds(std::uint64_t raw) const noexcept
+		{
+			return (_tsc != nullptr) ? _tsc->to_nanoseconds(raw) : static_cast<std::int64_t>(raw);
+		}
+
+		const tsc_clock* _tsc;
+		std::uint64_t _start;
+		std::uint64_t _accumulated;
+		bool _running;
+	};
+}
+
+#endif /* STOPWATCH_HPP */
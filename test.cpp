@@ -1,16 +1,31 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 #include <string>
+#include <system_error>
 #include <vector>
 #include <map>
+#include <random>
 #include "property.hpp"
 #include "date_time.hpp"
+#include "date_column.hpp"
+#include "timestamp_codec.hpp"
+#include "business_calendar.hpp"
+#include "date_time_format.hpp"
+#include "timing_wheel.hpp"
+#include "time_zone.hpp"
+#include "formatted_clock.hpp"
 
-/* This was tested on MSVC only and works for C++14, C++17, C++20 standards (haven't tested for other standards */
+/* Needs at least C++17 (the date_time headers use <charconv> and inline variables), tested for the C++17 and C++20 standards */
 
 class Employee
 {
 public:
-	dt0::property<__int64> Id {0, dt0::get<__int64>{}, dt0::set<__int64>{}};
+	dt0::property<long long> Id {0, dt0::get<long long>{}, dt0::set<long long>{}};
 	dt0::property<std::string> Name {dt0::get<std::string>{}, dt0::set<std::string>{}};
 	dt0::property<std::string> Surname {dt0::get<std::string>{}, dt0::set<std::string>{}};
 	dt0::property<unsigned short> Age {0, dt0::get<unsigned short >{}, dt0::set<unsigned short>{}};
@@ -18,7 +33,7 @@ public:
 
 	Employee() noexcept = default;
 
-	Employee(__int64 id, std::string name, std::string surname, unsigned short age, unsigned int salary)
+	Employee(long long id, std::string name, std::string surname, unsigned short age, unsigned int salary)
 	{
 		Id = id;
 		Name = name;
@@ -30,8 +45,588 @@ public:
 	~Employee() noexcept = default;
 };
 
+namespace
+{
+	int failures = 0;
+
+	/* Reports a failed check, main returns how many failed */
+	void check(bool condition, const char* what)
+	{
+		if (!condition)
+		{
+			++failures;
+			std::cout << "FAILED: " << what << '\n';
+		}
+	}
+
+	/* Every day of the flat table against the arithmetic conversions */
+	void test_civil_table()
+	{
+		const dt0::civil_table& table = dt0::civil_table::instance();
+		bool same = true;
+
+		check(!dt0::civil_table::contains(-1) && !dt0::civil_table::contains(dt0::civil_table::size) && (dt0::days_from_civil(2101, 1, 1) == dt0::civil_table::size),
+			"civil table covers 1970 to 2100");
+
+		for (std::int64_t days = 0; days < dt0::civil_table::size; ++days)
+		{
+			const dt0::civil_date C = dt0::civil_from_days(days);
+			const dt0::civil_date T = table.to_civil(days);
+
+			same = same && (T.y == C.y) && (T.m == C.m) && (T.d == C.d) && (table.weekday(days) == dt0::weekday_from_days(days))
+				&& (table.day_of_year(days) == dt0::day_of_year(C.y, C.m, C.d)) && (table.to_days(C.y, C.m, C.d) == days);
+		}
+
+		check(same, "civil table matches civil_from_days and days_from_civil");
+	}
+
+	/* The SSE path takes plain YYYY-MM-DDTHH:MM heads, a sign sends the same text through the scalar path */
+	void test_iso8601()
+	{
+		const char* text = "2026-10-17T14:03:22.25+02:00";
+		dt0::timestamp parsed;
+
+		check(dt0::from_chars(text, text + std::strlen(text), parsed).ec == std::errc(), "ISO 8601 parses");
+		check(parsed.ticks() == dt0::days_from_civil(2026, 10, 17) * dt0::ticks_per_day + 12 * dt0::ticks_per_hour + 3 * dt0::ticks_per_minute
+			+ 22 * dt0::ticks_per_second + 250 * dt0::ticks_per_millisecond, "ISO 8601 offset is applied");
+
+		const char* scalar = "+2026-10-17T14:03:22.25+02:00";
+		dt0::timestamp slow;
+
+		check((dt0::from_chars(scalar, scalar + std::strlen(scalar), slow).ec == std::errc()) && (slow == parsed), "ISO 8601 SSE and scalar paths agree");
+
+		/* Boundary years round trip through to_chars, the ones whose ticks would overflow are out of range at the first year digit */
+		for (const std::int64_t y : { std::int64_t(0), std::int64_t(1), std::int64_t(9999), std::int64_t(10000), std::int64_t(-25000), std::int64_t(31000) })
+		{
+			const dt0::timestamp value(dt0::days_from_civil(y, 12, 31) * dt0::ticks_per_day + 23 * dt0::ticks_per_hour + 59 * dt0::ticks_per_minute + 1234567);
+			char buffer[48];
+			const std::to_chars_result written = value.to_chars(buffer, buffer + sizeof(buffer), 7, true);
+			dt0::timestamp back;
+
+			check((dt0::from_chars(buffer, written.ptr, back).ec == std::errc()) && (back == value), "ISO 8601 round trip");
+		}
+
+		for (const char* far : { "+31200-01-01T00:00:00Z", "-27300-01-01", "+999999999999-01-01T00:00:00Z" })
+		{
+			dt0::date_time ignored;
+			const std::from_chars_result result = dt0::from_chars(far, far + std::strlen(far), ignored);
+
+			check((result.ec == std::errc::result_out_of_range) && (result.ptr == far + 1), "ISO 8601 year out of range");
+		}
+
+		const char* invalid = "2026-02-29";
+
+		check(dt0::from_chars(invalid, invalid + std::strlen(invalid), parsed).ec == std::errc::invalid_argument, "ISO 8601 rejects February 29 2026");
+	}
+
+	/* Radix sorts against std::sort, and the comparison keys and hashes of every type against plain tick order */
+	void test_ordering()
+	{
+		std::mt19937_64 random(11);
+		std::vector<std::int64_t> ticks(3001);
+
+		for (std::int64_t& value : ticks)
+			value = static_cast<std::int64_t>(random() % (400 * 366 * static_cast<std::uint64_t>(dt0::ticks_per_day))) - 200 * 366 * dt0::ticks_per_day;
+
+		for (std::size_t i = 0; i < 300; ++i)
+			ticks[i * 10] = ticks[i];
+
+		ticks[5] = INT64_MIN;
+		ticks[6] = INT64_MAX;
+
+		std::vector<std::int64_t> sorted = ticks;
+		std::vector<std::int64_t> expected = ticks;
+
+		dt0::radix_sort(sorted.data(), sorted.data() + sorted.size());
+		std::sort(expected.begin(), expected.end());
+		check(sorted == expected, "radix_sort of ticks matches std::sort");
+
+		std::vector<dt0::timestamp> timestamps;
+		std::vector<dt0::date_time> date_times;
+
+		for (std::size_t i = 7; i < ticks.size(); ++i)
+		{
+			timestamps.push_back(dt0::timestamp(ticks[i]));
+			date_times.push_back(dt0::date_time::from_ticks(ticks[i]));
+		}
+
+		std::vector<dt0::date_time> sorted_date_times = date_times;
+
+		dt0::radix_sort(timestamps.data(), timestamps.data() + timestamps.size());
+		dt0::radix_sort(sorted_date_times.data(), sorted_date_times.data() + sorted_date_times.size());
+		std::sort(date_times.begin(), date_times.end());
+
+		check(std::is_sorted(timestamps.begin(), timestamps.end()), "radix_sort of timestamps matches std::sort");
+		check(sorted_date_times == date_times, "radix_sort of date_times matches std::sort");
+
+		for (std::size_t i = 1; i < date_times.size(); ++i)
+		{
+			const dt0::date_time& a = date_times[i - 1];
+			const dt0::date_time& b = date_times[i];
+			const bool less = a.ticks() < b.ticks();
+
+			check((a < b) == less && (a == b) == !less && (timestamps[i - 1] < timestamps[i]) == less, "date_time and timestamp order follows ticks");
+			check((a.get_date().order_key() < b.get_date().order_key()) == (a.get_date().days_since_epoch() < b.get_date().days_since_epoch())
+				&& (a.get_date().get_year() < b.get_date().get_year()) == (a.get_date().get_year().astronomical() < b.get_date().get_year().astronomical()),
+				"date and year order keys follow the calendar");
+			check((a.get_date() != b.get_date()) || ((a.get_time() < b.get_time()) == less), "time order follows the time of day");
+#if ___cpp20___
+			check((a <=> b) == (a.ticks() <=> b.ticks()) && (timestamps[i - 1] <=> timestamps[i]) == (a.ticks() <=> b.ticks()), "three way comparison follows ticks");
+#endif
+			check(!(a == b) || ((std::hash<dt0::date_time>{}(a) == std::hash<dt0::date_time>{}(b)) && (std::hash<dt0::timestamp>{}(timestamps[i - 1]) == std::hash<dt0::timestamp>{}(timestamps[i]))),
+				"equal values hash alike");
+		}
+	}
+
+	/* The field kernels (AVX2 when built with it) against the scalar calendar, on an odd length so the tail runs scalar */
+	void test_extract()
+	{
+		std::mt19937_64 random(7);
+		std::vector<std::int64_t> ticks(1021);
+
+		for (std::int64_t& value : ticks)
+			value = static_cast<std::int64_t>(random() % (4000 * 366 * static_cast<std::uint64_t>(dt0::ticks_per_day))) - 2000 * 366 * dt0::ticks_per_day;
+
+		ticks[0] = -1;
+		ticks[1] = 0;
+		ticks[ticks.size() - 1] = -dt0::ticks_per_day;
+
+		std::vector<std::int32_t> years(ticks.size());
+		std::vector<std::uint8_t> months(ticks.size()), days(ticks.size()), weekdays(ticks.size()), hours(ticks.size());
+
+		dt0::extract_years(ticks.data(), ticks.size(), years.data());
+		dt0::extract_months(ticks.data(), ticks.size(), months.data());
+		dt0::extract_days(ticks.data(), ticks.size(), days.data());
+		dt0::extract_weekdays(ticks.data(), ticks.size(), weekdays.data());
+		dt0::extract_hours(ticks.data(), ticks.size(), hours.data());
+
+		for (std::size_t i = 0; i < ticks.size(); ++i)
+		{
+			const std::int64_t serial = dt0::days_from_ticks(ticks[i]);
+			const dt0::civil_date C = dt0::civil_from_days(serial);
+
+			check((years[i] == C.y) && (months[i] == C.m) && (days[i] == C.d), "column year, month and day match civil_from_days");
+			check(weekdays[i] == dt0::weekday_from_days(serial), "column week index matches weekday_from_days");
+			check(hours[i] == (ticks[i] - serial * dt0::ticks_per_day) / dt0::ticks_per_hour, "column hour matches the time of day");
+		}
+	}
+
+	/* The column kernels (AVX2 when built with it) have to give exactly what bucket_of gives one value at a time */
+	void test_buckets()
+	{
+		std::mt19937_64 random(13);
+		std::vector<std::int64_t> ticks(1003);
+
+		for (std::int64_t& value : ticks)
+			value = static_cast<std::int64_t>(random() % (200 * 366 * static_cast<std::uint64_t>(dt0::ticks_per_day))) - 70 * 366 * dt0::ticks_per_day;
+
+		std::vector<std::int64_t> buckets(ticks.size());
+
+		for (int unit = 0; unit <= static_cast<int>(dt0::time_unit::year); ++unit)
+		{
+			dt0::bucket_ticks(ticks.data(), ticks.size(), static_cast<dt0::time_unit>(unit), buckets.data());
+
+			for (std::size_t i = 0; i < ticks.size(); ++i)
+			{
+				const std::int64_t floor = dt0::floor_ticks(ticks[i], static_cast<dt0::time_unit>(unit));
+
+				check(buckets[i] == dt0::bucket_of(ticks[i], static_cast<dt0::time_unit>(unit)), "calendar bucket column matches bucket_of");
+				check((floor <= ticks[i]) && (dt0::bucket_start(buckets[i], static_cast<dt0::time_unit>(unit)) == floor), "calendar bucket starts at its floor");
+			}
+		}
+
+		for (const std::int64_t width : { 15 * dt0::ticks_per_minute, dt0::ticks_per_day, 7 * dt0::ticks_per_day, 7 * dt0::ticks_per_second + 3 })
+		{
+			dt0::bucket_ticks(ticks.data(), ticks.size(), width, 5 * dt0::ticks_per_hour, buckets.data());
+
+			for (std::size_t i = 0; i < ticks.size(); ++i)
+				check(buckets[i] == dt0::bucket_of(ticks[i], width, 5 * dt0::ticks_per_hour), "fixed window column matches bucket_of");
+		}
+	}
+
+	/* Regular ticks with jitter, gaps and the extremes, read back whole, in ranges, one at a time and after a restore */
+	void test_codec()
+	{
+		std::mt19937_64 random(17);
+		std::vector<std::int64_t> ticks;
+		std::int64_t value = dt0::days_from_civil(2026, 1, 1) * dt0::ticks_per_day;
+
+		for (int i = 0; i < 5000; ++i)
+		{
+			value += dt0::ticks_per_second + static_cast<std::int64_t>(random() % 2000) - 1000;
+
+			if (i % 997 == 0)
+				value += static_cast<std::int64_t>(random() % (1ull << 40));
+
+			ticks.push_back(value);
+		}
+
+		ticks.push_back(INT64_MAX);
+		ticks.push_back(INT64_MIN);
+		ticks.push_back(0);
+
+		dt0::timestamp_codec codec(256);
+
+		for (const std::int64_t tick : ticks)
+			codec.append(tick);
+
+		std::vector<std::int64_t> decoded(ticks.size());
+
+		codec.decode(decoded.data());
+		check((codec.size() == ticks.size()) && (decoded == ticks), "codec round trip");
+		check(codec.size_bytes() < ticks.size() * 3, "codec packs regular ticks into a few bits each");
+
+		codec.decode(700, 300, decoded.data());
+		check(std::equal(decoded.begin(), decoded.begin() + 300, ticks.begin() + 700), "codec decodes a range across blocks");
+		check((codec.ticks(0) == ticks[0]) && (codec.ticks(4321) == ticks[4321]) && (codec.ticks(ticks.size() - 2) == INT64_MIN), "codec random access");
+
+		dt0::timestamp_codec restored(codec.data(), codec.size_bytes(), codec.size(), 256);
+
+		restored.append(42);
+		check((restored.ticks(ticks.size() - 1) == 0) && (restored.ticks(ticks.size()) == 42), "codec restores and keeps appending");
+	}
+
+	/* The popcount ranks and select against a plain walk over the days, up to and including the end of the calendar */
+	void test_business_calendar()
+	{
+		dt0::business_calendar calendar(2024, 2027);
+
+		calendar.add_holiday(dt0::date::from_days(dt0::days_from_civil(2024, 12, 25)));
+		calendar.add_holiday(dt0::date::from_days(dt0::days_from_civil(2026, 1, 1)));
+		calendar.add_holiday(dt0::date::from_days(dt0::days_from_civil(2027, 12, 31)));
+
+		const std::int64_t first = dt0::days_from_civil(2024, 1, 1);
+		const std::int64_t end = dt0::days_from_civil(2028, 1, 1);
+		std::vector<std::int64_t> business;
+
+		for (std::int64_t d = first; d < end; ++d)
+		{
+			const unsigned short int weekday = dt0::weekday_from_days(d);
+			const bool holiday = (d == dt0::days_from_civil(2024, 12, 25)) || (d == dt0::days_from_civil(2026, 1, 1)) || (d == dt0::days_from_civil(2027, 12, 31));
+
+			check(calendar.is_business_day(d) == ((weekday < 6) && !holiday), "business day bitmap");
+
+			if ((weekday < 6) && !holiday)
+				business.push_back(d);
+		}
+
+		check(calendar.count(first, end) == static_cast<std::int64_t>(business.size()), "business days counted through the end of the calendar");
+
+		for (std::size_t i = 0; i < business.size(); i += 37)
+		{
+			check(calendar.count(first, business[i]) == static_cast<std::int64_t>(i), "business day rank");
+			check(calendar.add_business_days(business[0], static_cast<std::int64_t>(i)) == business[i], "business day select");
+			check((i == 0) || (calendar.previous(business[i]) == business[i - 1]), "previous business day");
+			check((i + 1 == business.size()) || (calendar.next(business[i]) == business[i + 1]), "next business day");
+		}
+	}
+
+	/* Compiled patterns against known text and against the independent RFC 3339 writer of timestamp */
+	void test_format()
+	{
+		const dt0::date_time value = dt0::date_time::from_ticks(dt0::days_from_civil(2026, 10, 7) * dt0::ticks_per_day + 14 * dt0::ticks_per_hour
+			+ 3 * dt0::ticks_per_minute + 22 * dt0::ticks_per_second + 250 * dt0::ticks_per_millisecond);
+
+		check(dt0::date_time_format("%d/%b/%Y:%T").as_string(value) == "07/Oct/2026:14:03:22", "format common log layout");
+		check(dt0::date_time_format("%A %e %B %y, %I:%M%p").as_string(value) == "Wednesday  7 October 26, 02:03PM", "format names and 12 hour clock");
+		check(dt0::date_time_format("%a %u %j 100%%").as_string(value) == "Wed 3 280 100%", "format week index, day of year and percent");
+
+		char small[8];
+
+		check(dt0::date_time_format("%F").to_chars(small, small + sizeof(small), value).ec == std::errc::value_too_large, "format reports a short buffer");
+
+		const dt0::date_time_format rfc3339("%Y-%m-%dT%H:%M:%S.%7fZ");
+		std::mt19937_64 random(21);
+		std::vector<std::int64_t> ticks(500);
+
+		for (std::int64_t& tick : ticks)
+			tick = static_cast<std::int64_t>(random() % (12000 * 366 * static_cast<std::uint64_t>(dt0::ticks_per_day))) - 2000 * 366 * dt0::ticks_per_day;
+
+		std::vector<char> bulk(ticks.size() * (rfc3339.max_size() + 1));
+		const char* line = bulk.data();
+		const char* const bulk_end = rfc3339.format(ticks.data(), ticks.size(), bulk.data());
+
+		for (const std::int64_t tick : ticks)
+		{
+			char expected[48];
+			const std::to_chars_result written = dt0::timestamp(tick).to_chars(expected, expected + sizeof(expected), 7, true);
+			const std::string text = rfc3339.as_string(dt0::timestamp(tick));
+			const char* const next = static_cast<const char*>(std::memchr(line, '\n', static_cast<std::size_t>(bulk_end - line)));
+
+			check(text == std::string(expected, written.ptr), "format matches timestamp::to_chars");
+			check((next != nullptr) && (std::string(line, next) == text), "bulk format matches one at a time");
+
+			line = (next != nullptr) ? next + 1 : bulk_end;
+		}
+	}
+
+	/* Text written by a pattern parses back to the same ticks, through the fixed layout fast path and through the operations */
+	void test_parse()
+	{
+		std::mt19937_64 random(22);
+
+		const struct { const char* pattern; std::int64_t precision; } layouts[] =
+		{
+			{ "%Y-%m-%d %H:%M:%S.%f", dt0::ticks_per_millisecond },
+			{ "%d/%b/%Y:%H:%M:%S", dt0::ticks_per_second },
+			{ "%a, %d %b %Y %T", dt0::ticks_per_second },
+			{ "%Y%j %I%M%S%p", dt0::ticks_per_second }
+		};
+
+		for (const auto& entry : layouts)
+		{
+			const dt0::date_time_format layout(entry.pattern);
+
+			for (int i = 0; i < 200; ++i)
+			{
+				const std::int64_t tick = dt0::floor_ticks(static_cast<std::int64_t>(random() % (9000 * 366 * static_cast<std::uint64_t>(dt0::ticks_per_day)))
+					- 1900 * 366 * dt0::ticks_per_day, entry.precision);
+
+				const std::string text = layout.as_string(dt0::timestamp(tick));
+				std::int64_t back = 0;
+				const std::from_chars_result result = layout.from_chars(text.data(), text.data() + text.size(), back);
+
+				check((result.ec == std::errc()) && (result.ptr == text.data() + text.size()) && (back == tick), "parse round trip");
+			}
+		}
+
+		const dt0::date_time_format clf("%d/%b/%Y:%H:%M:%S %z");
+		const char* text = "7/oct/2026:14:03:22 +0200";
+		dt0::timestamp parsed;
+
+		check((clf.from_chars(text, text + std::strlen(text), parsed).ec == std::errc())
+			&& (parsed.ticks() == dt0::days_from_civil(2026, 10, 7) * dt0::ticks_per_day + 12 * dt0::ticks_per_hour + 3 * dt0::ticks_per_minute + 22 * dt0::ticks_per_second),
+			"parse short day, lower case month and offset");
+
+		const dt0::date_time_format hour24("%H:%M:%S %p");
+		const char* afternoon = "15:00:00 AM";
+		std::int64_t hour = 0;
+
+		check((hour24.from_chars(afternoon, afternoon + std::strlen(afternoon), hour).ec == std::errc()) && (hour == 15 * dt0::ticks_per_hour),
+			"%p does not change a 24 hour %H");
+
+		const char* february = "30/Feb/2026:00:00:00 +0000";
+		const std::from_chars_result invalid = clf.from_chars(february, february + std::strlen(february), parsed);
+
+		check((invalid.ec == std::errc::invalid_argument) && (invalid.ptr == february), "parse blames an invalid day");
+
+		/* Boundary years, expanded ones round trip while their ticks fit and are out of range at the year field beyond */
+		const dt0::date_time_format iso("%Y-%m-%d");
+
+		for (const std::int64_t y : { std::int64_t(0), std::int64_t(9999), std::int64_t(-27000), std::int64_t(31000) })
+		{
+			const std::int64_t tick = dt0::days_from_civil(y, 6, 1) * dt0::ticks_per_day;
+			const std::string written = iso.as_string(dt0::timestamp(tick));
+			std::int64_t back = 0;
+
+			check((iso.from_chars(written.data(), written.data() + written.size(), back).ec == std::errc()) && (back == tick), "parse boundary year round trip");
+		}
+
+		for (const char* far : { "+999999999-01-01", "-900000-01-01", "+31200-01-01" })
+		{
+			std::int64_t ignored = 0;
+			const std::from_chars_result result = iso.from_chars(far, far + std::strlen(far), ignored);
+
+			check((result.ec == std::errc::result_out_of_range) && (result.ptr == far + 1), "parse year out of range");
+		}
+	}
+
+	/* Timers on every level and past the last one fire in deadline order, exactly when the clock reaches them, and cancelled ones never do */
+	void test_timing_wheel()
+	{
+		const std::int64_t start = dt0::days_from_civil(2026, 10, 17) * dt0::ticks_per_day;
+		dt0::timing_wheel<std::size_t> wheel(start);
+		std::mt19937_64 random(23);
+		std::vector<std::int64_t> deadlines;
+		std::vector<dt0::timing_wheel<std::size_t>::timer_id> ids;
+		std::vector<bool> cancelled;
+
+		for (std::size_t i = 0; i < 3000; ++i)
+		{
+			const std::uint64_t reach = (i % 3 == 0) ? 1000 : ((i % 3 == 1) ? 20000000 : 100ull * 24 * 3600 * 1000);
+
+			deadlines.push_back(start + static_cast<std::int64_t>(random() % reach) * dt0::ticks_per_millisecond);
+			ids.push_back(wheel.schedule(deadlines.back(), i));
+			cancelled.push_back(i % 7 == 0);
+		}
+
+		for (std::size_t i = 0; i < ids.size(); i += 7)
+			check(wheel.cancel(ids[i]), "timing wheel cancels a pending timer");
+
+		std::vector<bool> fired(ids.size(), false);
+		std::int64_t now = start;
+		std::int64_t last_deadline = start;
+		bool on_time = true;
+
+		while (!wheel.empty())
+		{
+			now += static_cast<std::int64_t>(random() % 3600000) * dt0::ticks_per_millisecond;
+
+			wheel.advance(now, [&](std::size_t& i)
+			{
+				on_time = on_time && !fired[i] && !cancelled[i] && (deadlines[i] <= now) && (deadlines[i] >= last_deadline);
+				fired[i] = true;
+				last_deadline = deadlines[i];
+			});
+
+			for (std::size_t i = 0; i < ids.size(); ++i)
+				on_time = on_time && (fired[i] == (!cancelled[i] && (deadlines[i] <= now)));
+		}
+
+		check(on_time, "timing wheel fires in deadline order when the clock reaches the deadline");
+		check(!wheel.cancel(ids[1]) && !wheel.pending(ids[1]), "a fired timer is no longer pending");
+	}
+
+	/* A TZif header (version, then the six counts from isutcnt to charcnt) followed by body */
+	std::vector<unsigned char> tzif(char version, std::initializer_list<std::uint32_t> counts, std::initializer_list<unsigned char> body, std::size_t padding = 0)
+	{
+		std::vector<unsigned char> file = { 'T', 'Z', 'i', 'f', static_cast<unsigned char>(version) };
+
+		file.resize(20, 0);
+
+		for (const std::uint32_t count : counts)
+		{
+			for (int shift = 24; shift >= 0; shift -= 8)
+				file.push_back(static_cast<unsigned char>(count >> shift));
+		}
+
+		file.insert(file.end(), body);
+		file.resize(file.size() + padding, 0);
+
+		return file;
+	}
+
+	/* Zone files with counts that do not fit their size have to be refused before anything is read past the mapping */
+	void test_time_zone_files()
+	{
+#ifndef _WIN32
+		const std::filesystem::path directory = std::filesystem::temp_directory_path() / "dt0_test_zoneinfo";
+		const char* const previous = std::getenv("TZDIR");
+		const std::string saved = (previous != nullptr) ? previous : "";
+
+		std::filesystem::create_directories(directory);
+		::setenv("TZDIR", directory.c_str(), 1);
+
+		const auto write = [&directory](const char* name, const std::vector<unsigned char>& bytes)
+		{
+			std::ofstream(directory / name, std::ios::binary).write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		};
+
+		/* One transition at 0 to a +01:00 type named ABC */
+		write("valid", tzif('1', { 0, 0, 0, 1, 1, 4 }, { 0, 0, 0, 0, 0, 0, 0, 0x0E, 0x10, 0, 0, 'A', 'B', 'C', 0 }));
+		write("huge_transitions", tzif('1', { 0, 0, 0, 0xFFFFFFFFu, 1, 4 }, {}, 1541));
+		write("huge_types", tzif('1', { 0, 0, 0, 0, 0xFFFFFFFFu, 4 }, {}, 1541));
+		write("huge_chars", tzif('1', { 0, 0, 0, 0, 1, 0xFFFFFFF0u }, {}, 1541));
+		write("huge_leaps", tzif('1', { 0, 0, 0xFFFFFFFFu, 0, 1, 4 }, {}, 1541));
+		write("truncated", tzif('1', { 0, 0, 0, 100, 1, 4 }, {}, 50));
+
+		std::vector<unsigned char> second = tzif('2', { 0, 0, 0, 0, 1, 0 }, { 0, 0, 0, 0, 0, 0 });
+		const std::vector<unsigned char> huge = tzif('2', { 0, 0, 0, 0xFFFFFFFFu, 1, 4 }, {}, 1500);
+
+		second.insert(second.end(), huge.begin(), huge.end());
+		write("huge_version2", second);
+
+		try
+		{
+			const dt0::time_zone zone("valid");
+
+			check((zone.offset_ticks(dt0::ticks_per_day) == dt0::ticks_per_hour) && (zone.abbreviation(dt0::ticks_per_day) == "ABC"), "a minimal zone file loads");
+		}
+		catch (const dt0::basic_error&)
+		{
+			check(false, "a minimal zone file loads");
+		}
+
+		for (const char* name : { "huge_transitions", "huge_types", "huge_chars", "huge_leaps", "truncated", "huge_version2" })
+		{
+			bool refused = false;
+
+			try
+			{
+				const dt0::time_zone zone(name);
+			}
+			catch (const dt0::basic_error&)
+			{
+				refused = true;
+			}
+
+			check(refused, "a zone file with impossible counts is refused");
+		}
+
+		if (previous != nullptr)
+			::setenv("TZDIR", saved.c_str(), 1);
+		else
+			::unsetenv("TZDIR");
+
+		std::filesystem::remove_all(directory);
+#endif
+	}
+
+	/* Every cached text is what the matching pattern writes for the start of the current tick, give or take one tick */
+	void test_formatted_clock()
+	{
+		const dt0::formatted_clock clock(dt0::ticks_per_second);
+		const struct { dt0::time_layout layout; const char* pattern; bool utc; } layouts[] =
+		{
+			{ dt0::time_layout::iso8601, "%Y-%m-%d %H:%M:%S.%f", false },
+			{ dt0::time_layout::rfc3339, "%Y-%m-%dT%H:%M:%S.%fZ", true },
+			{ dt0::time_layout::common_log, "%d/%b/%Y:%H:%M:%S ", false },
+			{ dt0::time_layout::http, "%a, %d %b %Y %H:%M:%S GMT", true },
+			{ dt0::time_layout::syslog, "%b %e %H:%M:%S", false }
+		};
+
+		for (const auto& entry : layouts)
+		{
+			const dt0::date_time_format format(entry.pattern);
+			const std::int64_t before = dt0::utc_ticks();
+			char text[dt0::formatted_clock::max_chars];
+			const std::size_t length = clock.read(entry.layout, text);
+			const std::int64_t after = dt0::utc_ticks();
+			bool found = false;
+
+			check(length == dt0::formatted_clock::size(entry.layout), "formatted clock text has its layout's size");
+
+			for (std::int64_t tick = dt0::floor_div(before, dt0::ticks_per_second) - 1; tick <= dt0::floor_div(after, dt0::ticks_per_second); ++tick)
+			{
+				const std::int64_t utc = tick * dt0::ticks_per_second;
+				const std::int64_t offset = entry.utc ? 0 : dt0::local_offset_ticks(utc);
+				std::string expected = format.as_string(dt0::timestamp(utc + offset));
+
+				if (entry.layout == dt0::time_layout::common_log)
+				{
+					const std::int64_t minutes = ((offset < 0) ? -offset : offset) / dt0::ticks_per_minute;
+
+					expected += (offset < 0) ? '-' : '+';
+					expected += static_cast<char>('0' + minutes / 600);
+					expected += static_cast<char>('0' + minutes / 60 % 10);
+					expected += static_cast<char>('0' + minutes % 60 / 10);
+					expected += static_cast<char>('0' + minutes % 10);
+				}
+
+				found = found || (std::string(text, length) == expected);
+			}
+
+			check(found, "formatted clock text matches date_time_format for the current tick");
+		}
+	}
+
+}
+
 int main()
 {
+	test_civil_table();
+	test_iso8601();
+	test_ordering();
+	test_extract();
+	test_buckets();
+	test_codec();
+	test_business_calendar();
+	test_format();
+	test_parse();
+	test_timing_wheel();
+	test_time_zone_files();
+	test_formatted_clock();
+
 	dt0::date_time _now = dt0::date_time::now();
 
 	std::cout << _now.get_date().get_day().month_index() << '.' << _now.get_date().get_month().name() << '.' << _now.get_date().get_year().value() << "\n";
@@ -74,5 +669,8 @@ int main()
 		  << "\nSurname: " << employee.Surname
 		  << "\nAge: " << employee.Age
 		  << "\nSalary: " << employee.Salary << "$\n\n";
-	return 0;
+
+	std::cout << failures << " failed checks\n";
+
+	return failures;
 }
@@ -0,0 +1,620 @@
+#ifndef TIME_ZONE_HPP
+#define TIME_ZONE_HPP
+
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+#include "mapped_file.hpp"
+
+/* The time_zone class converts between UTC and the local time of a tzdata zone such as "Europe/Berlin".
+The TZif file is mapped once, its transitions are converted to a sorted array of ticks and the mapping is released.
+Instants past the last transition follow the POSIX rule from the file footer, precomputed up to the year 2100 and
+evaluated on the fly after that.
+
+Zones are loaded through time_zone::locate(), which keeps every zone it has loaded for the rest of the program so the
+returned references never dangle. Conversions allocate nothing: a lookup first checks the transition interval of the
+previous hit and only falls back to a binary search when the instant is outside of it.
+Zone files are searched in the TZDIR environment variable or /usr/share/zoneinfo, leap second records are ignored. */
+
+namespace dt0
+{
+	namespace detail
+	{
+		/* Counts in TZif headers are unsigned, offsets and times are signed */
+		___nodiscard___ inline std::uint32_t read_be_u32(const unsigned char* p) noexcept
+		{
+			return (static_cast<std::uint32_t>(p[0]) << 24) | (static_cast<std::uint32_t>(p[1]) << 16)
+				| (static_cast<std::uint32_t>(p[2]) << 8) | static_cast<std::uint32_t>(p[3]);
+		}
+
+		___nodiscard___ inline std::int32_t read_be32(const unsigned char* p) noexcept
+		{
+			return static_cast<std::int32_t>(read_be_u32(p));
+		}
+
+		___nodiscard___ inline std::int64_t read_be64(const unsigned char* p) noexcept
+		{
+			return static_cast<std::int64_t>((static_cast<std::uint64_t>(read_be_u32(p)) << 32) | read_be_u32(p + 4));
+		}
+
+		/* A switch date of a POSIX TZ rule: Jn counts 1 to 365 and never counts February 29, n counts 0 to 365,
+		Mm.w.d is weekday d (0 is Sunday) of week w (5 is the last) of month m. The time is local wall time. */
+		struct tz_rule_date
+		{
+			char kind;
+			unsigned short int month;
+			unsigned short int week;
+			unsigned short int day;
+			std::int64_t time;
+		};
+
+		struct tz_rule
+		{
+			bool dst;
+			std::int64_t std_offset;
+			std::int64_t dst_offset;
+			std::string std_name;
+			std::string dst_name;
+			tz_rule_date start;
+			tz_rule_date end;
+		};
+
+		___nodiscard___ inline std::int64_t tz_rule_day(const tz_rule_date& rule, std::int64_t y) noexcept
+		{
+			const std::int64_t first = days_from_civil(y, 1, 1);
+
+			if (rule.kind == 'J')
+				return first + rule.day - 1 + ((is_leap_year(y) && (rule.day >= 60)) ? 1 : 0);
+
+			if (rule.kind == 'N')
+				return first + rule.day;
+
+			const std::int64_t month_first = days_from_civil(y, rule.month, 1);
+			const std::int64_t month_last = month_first + days_in_month(y, rule.month) - 1;
+			std::int64_t day = month_first + (rule.day + 7 - weekday_from_days(month_first) % 7) % 7 + (rule.week - 1) * 7;
+
+			while (day > month_last)
+				day -= 7;
+
+			return day;
+		}
+
+		/* Hours may run from -167 to 167 as RFC 8536 allows for the switch times */
+		___nodiscard___ inline bool parse_tz_time(std::string_view text, std::size_t& i, std::int64_t& ticks) noexcept
+		{
+			bool negative = false;
+
+			if ((i < text.size()) && ((text[i] == '+') || (text[i] == '-')))
+				negative = (text[i++] == '-');
+
+			std::int64_t parts[3] = { 0, 0, 0 };
+
+			for (unsigned int part = 0; part < 3; ++part)
+			{
+				if ((part > 0) && ((i >= text.size()) || (text[i] != ':')))
+					break;
+
+				if (part > 0)
+					++i;
+
+				const std::size_t start = i;
+
+				while ((i < text.size()) && (text[i] >= '0') && (text[i] <= '9') && (i - start < 3))
+					parts[part] = parts[part] * 10 + (text[i++] - '0');
+
+				if (i == start)
+					return false;
+			}
+
+			if ((parts[0] > 167) || (parts[1] > 59) || (parts[2] > 59))
+				return false;
+
+			ticks = parts[0] * ticks_per_hour + parts[1] * ticks_per_minute + parts[2] * ticks_per_second;
+
+			if (negative)
+				ticks = -ticks;
+
+			return true;
+		}
+
+		___nodiscard___ inline bool parse_tz_name(std::string_view text, std::size_t& i, std::string& name)
+		{
+			const std::size_t start = i;
+
+			if ((i < text.size()) && (text[i] == '<'))
+			{
+				const std::size_t close = text.find('>', i);
+
+				if (close == std::string_view::npos)
+					return false;
+
+				name = std::string(text.substr(i + 1, close - i - 1));
+				i = close + 1;
+			}
+
+			else
+			{
+				while ((i < text.size()) && (((text[i] | 0x20) >= 'a') && ((text[i] | 0x20) <= 'z')))
+					++i;
+
+				name = std::string(text.substr(start, i - start));
+			}
+
+			return name.size() >= 3;
+		}
+
+		___nodiscard___ inline std::size_t parse_tz_number(std::string_view text, std::size_t& i, unsigned short int& value) noexcept
+		{
+			const std::size_t start = i;
+
+			value = 0;
+
+			while ((i < text.size()) && (text[i] >= '0') && (text[i] <= '9') && (i - start < 3))
+				value = static_cast<unsigned short int>(value * 10 + (text[i++] - '0'));
+
+			return i - start;
+		}
+
+		___nodiscard___ inline bool parse_tz_rule_date(std::string_view text, std::size_t& i, tz_rule_date& rule) noexcept
+		{
+			rule = tz_rule_date{ 'N', 0, 0, 0, 2 * ticks_per_hour };
+
+			if ((i < text.size()) && (text[i] == 'M'))
+			{
+				rule.kind = 'M';
+				++i;
+
+				if ((parse_tz_number(text, i, rule.month) == 0) || (i >= text.size()) || (text[i++] != '.')
+					|| (parse_tz_number(text, i, rule.week) == 0) || (i >= text.size()) || (text[i++] != '.')
+					|| (parse_tz_number(text, i, rule.day) == 0))
+					return false;
+
+				if ((rule.month < 1) || (rule.month > 12) || (rule.week < 1) || (rule.week > 5) || (rule.day > 6))
+					return false;
+			}
+
+			else
+			{
+				if ((i < text.size()) && (text[i] == 'J'))
+				{
+					rule.kind = 'J';
+					++i;
+				}
+
+				if (parse_tz_number(text, i, rule.day) == 0)
+					return false;
+
+				if ((rule.kind == 'J') ? ((rule.day < 1) || (rule.day > 365)) : (rule.day > 365))
+					return false;
+			}
+
+			if ((i < text.size()) && (text[i] == '/'))
+				return parse_tz_time(text, ++i, rule.time);
+
+			return true;
+		}
+
+		/* std offset [dst [offset] [,start[/time],end[/time]]], the offsets count hours west of UTC */
+		___nodiscard___ inline bool parse_tz_rule(std::string_view text, tz_rule& rule)
+		{
+			std::size_t i = 0;
+			std::int64_t west = 0;
+
+			rule.dst = false;
+
+			if (!parse_tz_name(text, i, rule.std_name) || !parse_tz_time(text, i, west))
+				return false;
+
+			rule.std_offset = -west;
+			rule.dst_offset = rule.std_offset;
+
+			if (i == text.size())
+				return true;
+
+			if (!parse_tz_name(text, i, rule.dst_name))
+				return false;
+
+			rule.dst = true;
+			rule.dst_offset = rule.std_offset + ticks_per_hour;
+
+			if ((i < text.size()) && (text[i] != ','))
+			{
+				if (!parse_tz_time(text, i, west))
+					return false;
+
+				rule.dst_offset = -west;
+			}
+
+			/* Without switch dates POSIX leaves the rule to the implementation, the US rules are what everybody uses */
+			if (i == text.size())
+			{
+				rule.start = tz_rule_date{ 'M', 3, 2, 0, 2 * ticks_per_hour };
+				rule.end = tz_rule_date{ 'M', 11, 1, 0, 2 * ticks_per_hour };
+
+				return true;
+			}
+
+			return (text[i++] == ',') && parse_tz_rule_date(text, i, rule.start) && (i < text.size()) && (text[i++] == ',')
+				&& parse_tz_rule_date(text, i, rule.end) && (i == text.size());
+		}
+	}
+
+	class time_zone
+	{
+	public:
+		/* Loads the zone from the zoneinfo directory, prefer locate() which loads each zone only once */
+		explicit time_zone(std::string_view name) : _name(name), _last(0), _horizon(std::numeric_limits<std::int64_t>::max())
+		{
+			if (_name.empty() || (_name[0] == '/') || (_name.find("..") != std::string::npos))
+				throw basic_error("Invalid time zone name!");
+
+			const mapped_file _file(directory() + "/" + _name);
+
+			_load(_file.data(), _file.size());
+		}
+
+		time_zone(const time_zone&) = delete;
+		time_zone(time_zone&&) = delete;
+		const time_zone& operator= (const time_zone&) = delete;
+		const time_zone& operator= (time_zone&&) = delete;
+
+		~time_zone() noexcept = default;
+
+		___nodiscard___ static std::string directory()
+		{
+			const char* const _directory = std::getenv("TZDIR");
+
+			return ((_directory != nullptr) && (*_directory != '\0')) ? std::string(_directory) : std::string("/usr/share/zoneinfo");
+		}
+
+		/* Thread safe, the first call for a name loads the zone and every later call returns the same object */
+		___nodiscard___ static const time_zone& locate(std::string_view name)
+		{
+			static std::mutex _mutex;
+			static std::map<std::string, std::unique_ptr<time_zone>, std::less<>> _zones;
+
+			std::lock_guard<std::mutex> _lock(_mutex);
+
+			const auto found = _zones.find(name);
+
+			if (found != _zones.end())
+				return *found->second;
+
+			std::unique_ptr<time_zone> _zone(new time_zone(name));
+			const time_zone& zone = *_zone;
+
+			_zones.emplace(std::string(name), std::move(_zone));
+
+			return zone;
+		}
+
+		/* The zone named by the TZ environment variable or the /etc/localtime link, resolved on the first call */
+		___nodiscard___ static const time_zone& current()
+		{
+			static const time_zone& zone = locate(_current_name());
+
+			return zone;
+		}
+
+		___nodiscard___ const std::string& name() const noexcept
+		{
+			return _name;
+		}
+
+		/* Local time minus UTC at the given UTC instant */
+		___nodiscard___ std::int64_t offset_ticks(std::int64_t utc) const noexcept
+		{
+			return _types[_type_at(utc)].offset;
+		}
+
+		___nodiscard___ bool is_dst(std::int64_t utc) const noexcept
+		{
+			return _types[_type_at(utc)].dst;
+		}
+
+		/* The designation in effect at the given UTC instant, such as CET or CEST */
+		___nodiscard___ std::string_view abbreviation(std::int64_t utc) const noexcept
+		{
+			return std::string_view(_designations.c_str() + _types[_type_at(utc)].designation);
+		}
+
+		___nodiscard___ std::int64_t to_local(std::int64_t utc) const noexcept
+		{
+			return utc + offset_ticks(utc);
+		}
+
+		/* A local time repeated when the clocks go back maps to its earlier instant, a local time skipped when they
+		go forward is read with the offset from before the switch so it lands after it (02:30 becomes 03:30). */
+		___nodiscard___ std::int64_t to_utc(std::int64_t local) const noexcept
+		{
+			const std::int64_t before = offset_ticks(local - ticks_per_day);
+			const std::int64_t after = offset_ticks(local + ticks_per_day);
+
+			const std::int64_t first = local - before;
+			const std::int64_t second = local - after;
+
+			const bool first_valid = (offset_ticks(first) == before);
+			const bool second_valid = (offset_ticks(second) == after);
+
+			if (first_valid && second_valid)
+				return (first < second) ? first : second;
+
+			return (second_valid && !first_valid) ? second : first;
+		}
+
+		___nodiscard___ timestamp to_local(timestamp utc) const noexcept
+		{
+			return timestamp(to_local(utc.ticks()));
+		}
+
+		___nodiscard___ timestamp to_utc(timestamp local) const noexcept
+		{
+			return timestamp(to_utc(local.ticks()));
+		}
+
+		___nodiscard___ date_time to_local(const date_time& utc) const
+		{
+			return date_time::from_ticks(to_local(utc.ticks()));
+		}
+
+		___nodiscard___ date_time to_utc(const date_time& local) const
+		{
+			return date_time::from_ticks(to_utc(local.ticks()));
+		}
+
+	private:
+		struct zone_type
+		{
+			std::int64_t offset;
+			bool dst;
+			std::size_t designation;
+		};
+
+		static ___constexpr___ std::int64_t last_table_year = 2100;
+
+		static std::string _current_name()
+		{
+			const char* const _tz = std::getenv("TZ");
+
+			if ((_tz != nullptr) && (*_tz != '\0'))
+				return std::string(_tz + ((*_tz == ':') ? 1 : 0));
+
+#ifndef _WIN32
+			char _target[4096];
+			const ssize_t length = ::readlink("/etc/localtime", _target, sizeof(_target) - 1);
+
+			if (length > 0)
+			{
+				const std::string_view target(_target, static_cast<std::size_t>(length));
+				const std::size_t found = target.rfind("zoneinfo/");
+
+				if (found != std::string_view::npos)
+					return std::string(target.substr(found + 9));
+			}
+#endif
+
+			return "UTC";
+		}
+
+		/* The bytes of the data block after the header h, computed in 64 bits from unsigned counts so no count can wrap it.
+		Throws unless the counts are sane and the block fits in the available bytes. */
+		static std::size_t _block_size(const unsigned char* h, std::size_t time_size, std::size_t available)
+		{
+			const std::uint64_t transition_count = detail::read_be_u32(h + 32);
+			const std::uint64_t type_count = detail::read_be_u32(h + 36);
+			const std::uint64_t char_count = detail::read_be_u32(h + 40);
+
+			if ((type_count == 0) || (type_count > 256) || (transition_count > available / (time_size + 1)) || (char_count > available))
+				throw basic_error("Invalid time zone file!");
+
+			const std::uint64_t bytes = transition_count * (time_size + 1) + type_count * 6 + char_count
+				+ static_cast<std::uint64_t>(detail::read_be_u32(h + 28)) * (time_size + 4)
+				+ detail::read_be_u32(h + 24) + detail::read_be_u32(h + 20);
+
+			if (bytes > available)
+				throw basic_error("Invalid time zone file!");
+
+			return static_cast<std::size_t>(bytes);
+		}
+
+		void _load(const unsigned char* data, std::size_t size)
+		{
+			if ((size < 44) || (std::memcmp(data, "TZif", 4) != 0))
+				throw basic_error("Invalid time zone file!");
+
+			const unsigned char* const end = data + size;
+			const unsigned char* header = data;
+			std::size_t time_size = 4;
+
+			/* Version 2 and later repeat the data with 64 bit times after the version 1 block, only that copy is read */
+			if (data[4] >= '2')
+			{
+				const std::size_t skipped = _block_size(data, 4, size - 44);
+
+				if (size - 44 - skipped < 44)
+					throw basic_error("Invalid time zone file!");
+
+				header = data + 44 + skipped;
+				time_size = 8;
+
+				if (std::memcmp(header, "TZif", 4) != 0)
+					throw basic_error("Invalid time zone file!");
+			}
+
+			const unsigned char* const block = header + 44;
+			const std::size_t block_bytes = _block_size(header, time_size, static_cast<std::size_t>(end - block));
+			const std::size_t transition_count = detail::read_be_u32(header + 32);
+			const std::size_t type_count = detail::read_be_u32(header + 36);
+			const std::size_t char_count = detail::read_be_u32(header + 40);
+
+			const unsigned char* const times = block;
+			const unsigned char* const indexes = times + transition_count * time_size;
+			const unsigned char* const types = indexes + transition_count;
+			const unsigned char* const chars = types + type_count * 6;
+
+			_designations.assign(reinterpret_cast<const char*>(chars), char_count);
+			_designations.push_back('\0');
+
+			for (std::size_t i = 0; i < type_count; ++i)
+			{
+				const unsigned char* const type = types + i * 6;
+
+				if (type[5] >= char_count)
+					throw basic_error("Invalid time zone file!");
+
+				_types.push_back(zone_type{ detail::read_be32(type) * ticks_per_second, type[4] != 0, type[5] });
+			}
+
+			/* The first type covers everything before the first transition */
+			_transitions.push_back(std::numeric_limits<std::int64_t>::min());
+			_kinds.push_back(0);
+
+			const std::int64_t limit = std::numeric_limits<std::int64_t>::max() / ticks_per_second;
+
+			for (std::size_t i = 0; i < transition_count; ++i)
+			{
+				const std::int64_t seconds = (time_size == 8) ? detail::read_be64(times + i * 8) : detail::read_be32(times + i * 4);
+
+				if (indexes[i] >= type_count)
+					throw basic_error("Invalid time zone file!");
+
+				if ((seconds <= -limit) || (seconds >= limit))
+					continue;
+
+				_transitions.push_back(seconds * ticks_per_second);
+				_kinds.push_back(indexes[i]);
+			}
+
+			if (time_size == 8)
+			{
+				const unsigned char* const footer = block + block_bytes;
+
+				if ((footer < end) && (*footer == '\n'))
+				{
+					const unsigned char* const footer_end = static_cast<const unsigned char*>(std::memchr(footer + 1, '\n', static_cast<std::size_t>(end - footer - 1)));
+
+					if ((footer_end != nullptr) && (footer_end != footer + 1))
+						_load_rule(std::string_view(reinterpret_cast<const char*>(footer + 1), static_cast<std::size_t>(footer_end - footer - 1)));
+				}
+			}
+		}
+
+		/* Extends the table with the rule's switches up to the end of last_table_year */
+		void _load_rule(std::string_view text)
+		{
+			if (!detail::parse_tz_rule(text, _rule))
+				throw basic_error("Invalid time zone rule!");
+
+			if (!_rule.dst)
+				return;
+
+			_std_type = _find_type(_rule.std_offset, false, _rule.std_name);
+			_dst_type = _find_type(_rule.dst_offset, true, _rule.dst_name);
+
+			const std::int64_t last = _transitions.back();
+			const std::int64_t first_year = (_transitions.size() > 1) ? civil_from_days(days_from_ticks(last)).y : 1970;
+
+			for (std::int64_t y = first_year; y <= last_table_year; ++y)
+			{
+				std::int64_t start = 0;
+				std::int64_t end = 0;
+
+				_rule_switches(y, start, end);
+
+				const bool start_first = (start < end);
+
+				_append(start_first ? start : end, start_first ? _dst_type : _std_type);
+				_append(start_first ? end : start, start_first ? _std_type : _dst_type);
+			}
+
+			_horizon = days_from_civil(last_table_year + 1, 1, 1) * ticks_per_day;
+		}
+
+		void _append(std::int64_t transition, std::uint16_t kind)
+		{
+			if (transition <= _transitions.back())
+				return;
+
+			_transitions.push_back(transition);
+			_kinds.push_back(kind);
+		}
+
+		std::uint16_t _find_type(std::int64_t offset, bool dst, const std::string& name)
+		{
+			for (std::size_t i = 0; i < _types.size(); ++i)
+			{
+				if ((_types[i].offset == offset) && (_types[i].dst == dst) && (name == (_designations.c_str() + _types[i].designation)))
+					return static_cast<std::uint16_t>(i);
+			}
+
+			_types.push_back(zone_type{ offset, dst, _designations.size() });
+			_designations.append(name);
+			_designations.push_back('\0');
+
+			return static_cast<std::uint16_t>(_types.size() - 1);
+		}
+
+		/* UTC instants at which daylight saving time starts and ends in year y */
+		void _rule_switches(std::int64_t y, std::int64_t& start, std::int64_t& end) const noexcept
+		{
+			start = detail::tz_rule_day(_rule.start, y) * ticks_per_day + _rule.start.time - _rule.std_offset;
+			end = detail::tz_rule_day(_rule.end, y) * ticks_per_day + _rule.end.time - _rule.dst_offset;
+		}
+
+		___nodiscard___ std::size_t _type_at(std::int64_t utc) const noexcept
+		{
+			if (utc >= _horizon)
+			{
+				std::int64_t start = 0;
+				std::int64_t end = 0;
+
+				_rule_switches(civil_from_days(days_from_ticks(utc + _rule.std_offset)).y, start, end);
+
+				const bool dst = (start < end) ? ((utc >= start) && (utc < end)) : ((utc >= start) || (utc < end));
+
+				return dst ? _dst_type : _std_type;
+			}
+
+			std::size_t i = _last.load(std::memory_order_relaxed);
+
+			if ((_transitions[i] > utc) || ((i + 1 < _transitions.size()) && (_transitions[i + 1] <= utc)))
+			{
+				i = static_cast<std::size_t>(std::upper_bound(_transitions.begin() + 1, _transitions.end(), utc) - _transitions.begin()) - 1;
+
+				_last.store(i, std::memory_order_relaxed);
+			}
+
+			return _kinds[i];
+		}
+
+		std::string _name;
+		std::vector<std::int64_t> _transitions;
+		std::vector<std::uint16_t> _kinds;
+		std::vector<zone_type> _types;
+		std::string _designations;
+		mutable std::atomic<std::size_t> _last;
+		detail::tz_rule _rule;
+		std::uint16_t _std_type = 0;
+		std::uint16_t _dst_type = 0;
+		std::int64_t _horizon;
+	};
+}
+
+#endif /* TIME_ZONE_HPP */
@@ -0,0 +1,368 @@
+#ifndef TIMESTAMP_CODEC_HPP
+#define TIMESTAMP_CODEC_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+#include "bit_utilities.hpp"
+#include "binary_format.hpp"
+
+/* The timestamp_codec class stores a growing sequence of tick counts compressed with delta of delta coding in the style of
+Facebook's Gorilla. Equally spaced timestamps cost a single bit each and jitter of up to 127 ticks costs 10 bits.
+
+The sequence is cut into blocks of block_size values. Every block starts on a byte boundary with its first tick stored raw,
+then holds one code per following value, the zigzag encoded change of the delta prefixed by a width class:
+
+	0		the delta did not change
+	10		8 bit change
+	110		16 bit change
+	1110	24 bit change
+	11110	32 bit change
+	11111	64 bit change
+
+Bits are written least significant first into little endian bytes, so a decoder step is one unaligned load, a table lookup and a shift.
+Reading value i decodes only its block, bulk decoding runs block by block. */
+
+namespace dt0
+{
+	namespace detail
+	{
+		struct dod_class
+		{
+			unsigned char prefix;
+			unsigned char payload;
+		};
+
+		/* Indexed by the low five stream bits, whose trailing ones pick the width class */
+		inline ___constexpr___ dod_class dod_classes[32] =
+		{
+			{ 1, 0 }, { 2, 8 }, { 1, 0 }, { 3, 16 }, { 1, 0 }, { 2, 8 }, { 1, 0 }, { 4, 24 },
+			{ 1, 0 }, { 2, 8 }, { 1, 0 }, { 3, 16 }, { 1, 0 }, { 2, 8 }, { 1, 0 }, { 5, 32 },
+			{ 1, 0 }, { 2, 8 }, { 1, 0 }, { 3, 16 }, { 1, 0 }, { 2, 8 }, { 1, 0 }, { 4, 24 },
+			{ 1, 0 }, { 2, 8 }, { 1, 0 }, { 3, 16 }, { 1, 0 }, { 2, 8 }, { 1, 0 }, { 5, 64 }
+		};
+
+		___nodiscard___ ___constexpr___ std::uint64_t zigzag_encode(std::uint64_t value) noexcept
+		{
+			return (value << 1) ^ static_cast<std::uint64_t>(static_cast<std::int64_t>(value) >> 63);
+		}
+
+		___nodiscard___ ___constexpr___ std::uint64_t zigzag_decode(std::uint64_t value) noexcept
+		{
+			return (value >> 1) ^ (0 - (value & 1));
+		}
+
+		/* Where a walk through a block stands: the last value, the last delta and the next bit to read */
+		struct dod_cursor
+		{
+			std::uint64_t value;
+			std::uint64_t delta;
+			std::size_t bit;
+		};
+
+		/* Steps count values past the cursor, writing them to out when Store is set and only keeping the running value otherwise */
+		template <bool Store>
+		inline void walk_dod_block(const unsigned char* data, dod_cursor& cursor, std::size_t count, std::int64_t* out) noexcept
+		{
+			std::uint64_t value = cursor.value;
+			std::uint64_t delta = cursor.delta;
+			std::size_t bit = cursor.bit;
+			std::size_t i = 0;
+
+			while (i < count)
+			{
+				/* At least 57 valid bits */
+				const std::uint64_t word = load_le64(data + (bit >> 3)) >> (bit & 7);
+
+				/* Regular series are mostly unchanged deltas, a run of them is a run of zero bits */
+				if ((word & 1) == 0)
+				{
+					std::size_t run = count_trailing_zeros(word | (static_cast<std::uint64_t>(1) << 56));
+
+					if (run > count - i)
+						run = count - i;
+
+					bit += run;
+
+					if (Store)
+					{
+						for (const std::size_t last = i + run; i < last; ++i)
+						{
+							value += delta;
+							out[i] = static_cast<std::int64_t>(value);
+						}
+					}
+
+					else
+					{
+						value += delta * run;
+						i += run;
+					}
+
+					continue;
+				}
+
+				const dod_class c = dod_classes[word & 31];
+				std::uint64_t change;
+
+				if (c.payload == 64)
+				{
+					const std::size_t low = bit + 5;
+					const std::size_t high = bit + 37;
+
+					change = ((load_le64(data + (low >> 3)) >> (low & 7)) & 0xFFFFFFFFu) | ((load_le64(data + (high >> 3)) >> (high & 7)) << 32);
+				}
+
+				else
+					change = (word >> c.prefix) & ((static_cast<std::uint64_t>(1) << c.payload) - 1);
+
+				bit += static_cast<std::size_t>(c.prefix) + c.payload;
+				delta += zigzag_decode(change);
+				value += delta;
+
+				if (Store)
+					out[i] = static_cast<std::int64_t>(value);
+
+				++i;
+			}
+
+			cursor = dod_cursor{ value, delta, bit };
+		}
+
+		/* Decodes count values of the block starting at data from its skip-th value on into out, nothing is stored for the skipped
+		values. Returns the number of bits the block used up to the last value. */
+		inline std::size_t decode_dod_block(const unsigned char* data, std::size_t skip, std::size_t count, std::int64_t* out) noexcept
+		{
+			dod_cursor cursor{ load_le64(data), 0, 64 };
+
+			if (skip == 0)
+			{
+				out[0] = static_cast<std::int64_t>(cursor.value);
+				walk_dod_block<true>(data, cursor, count - 1, out + 1);
+			}
+
+			else
+			{
+				walk_dod_block<false>(data, cursor, skip - 1, nullptr);
+				walk_dod_block<true>(data, cursor, count, out);
+			}
+
+			return cursor.bit;
+		}
+	}
+
+	class timestamp_codec
+	{
+	public:
+		explicit timestamp_codec(std::size_t block_size = 1024) :
+			_block_size(block_size), _count(0), _bits(0), _previous(0), _delta(0)
+		{
+			if (block_size < 1)
+				throw basic_error("Invalid block size!");
+		}
+
+		/* Restores a codec from the bytes of another one (see data() and size_bytes()), appending can carry on afterwards */
+		timestamp_codec(const unsigned char* data, std::size_t bytes, std::size_t count, std::size_t block_size = 1024) : timestamp_codec(block_size)
+		{
+			/* A corrupt block can claim up to 69 bits per value, the extra room keeps its decoding inside the buffer */
+			_bytes.assign(data, data + bytes);
+			_bytes.resize(bytes + padding + 9 * _block_size, 0);
+
+			for (std::size_t first = 0; first < count; first += _block_size)
+			{
+				const std::size_t offset = (_bits + 7) >> 3;
+				const std::size_t values = ((count - first) < _block_size) ? (count - first) : _block_size;
+
+				if (offset + 8 > bytes)
+					throw basic_error("Truncated timestamp stream!");
+
+				/* Walking the block is enough, only its end and its last value and delta are kept */
+				detail::dod_cursor cursor{ detail::load_le64(_bytes.data() + offset), 0, 64 };
+
+				detail::walk_dod_block<false>(_bytes.data() + offset, cursor, values - 1, nullptr);
+
+				_offsets.push_back(offset);
+				_bits = offset * 8 + cursor.bit;
+
+				if (_bits > bytes * 8)
+					throw basic_error("Truncated timestamp stream!");
+
+				_previous = cursor.value;
+				_delta = cursor.delta;
+			}
+
+			_count = count;
+			_bytes.resize(bytes + padding);
+		}
+
+		timestamp_codec(const timestamp_codec&) = default;
+		timestamp_codec(timestamp_codec&&) noexcept = default;
+		timestamp_codec& operator= (const timestamp_codec&) = default;
+		timestamp_codec& operator= (timestamp_codec&&) noexcept = default;
+
+		~timestamp_codec() noexcept = default;
+
+		___nodiscard___ std::size_t size() const noexcept
+		{
+			return _count;
+		}
+
+		___nodiscard___ bool empty() const noexcept
+		{
+			return _count == 0;
+		}
+
+		___nodiscard___ std::size_t block_size() const noexcept
+		{
+			return _block_size;
+		}
+
+		/* The encoded stream, size_bytes() long */
+		___nodiscard___ const unsigned char* data() const noexcept
+		{
+			return _bytes.data();
+		}
+
+		___nodiscard___ std::size_t size_bytes() const noexcept
+		{
+			return (_bits + 7) >> 3;
+		}
+
+		void append(std::int64_t ticks)
+		{
+			const std::uint64_t value = static_cast<std::uint64_t>(ticks);
+
+			if ((_count % _block_size) == 0)
+			{
+				_bits = (_bits + 7) & ~static_cast<std::size_t>(7);
+				_offsets.push_back(_bits >> 3);
+
+				_write(value & 0xFFFFFFFFu, 32);
+				_write(value >> 32, 32);
+
+				_delta = 0;
+			}
+
+			else
+			{
+				const std::uint64_t delta = value - _previous;
+				const std::uint64_t change = detail::zigzag_encode(delta - _delta);
+
+				if (change == 0)
+					_write(0, 1);
+				else if (change < (static_cast<std::uint64_t>(1) << 8))
+					_write(1 | (change << 2), 10);
+				else if (change < (static_cast<std::uint64_t>(1) << 16))
+					_write(3 | (change << 3), 19);
+				else if (change < (static_cast<std::uint64_t>(1) << 24))
+					_write(7 | (change << 4), 28);
+				else if (change < (static_cast<std::uint64_t>(1) << 32))
+					_write(15 | (change << 5), 37);
+				else
+				{
+					_write(31, 5);
+					_write(change & 0xFFFFFFFFu, 32);
+					_write(change >> 32, 32);
+				}
+
+				_delta = delta;
+			}
+
+			_previous = value;
+			++_count;
+		}
+
+		void append(timestamp value)
+		{
+			append(value.ticks());
+		}
+
+		void append(const date_time& value)
+		{
+			append(value.ticks());
+		}
+
+		/* Walks the block holding the value up to it, so it costs up to block_size steps and allocates nothing */
+		___nodiscard___ std::int64_t ticks(std::size_t index) const
+		{
+			if (index >= _count)
+				throw basic_error("Index out of range!");
+
+			std::int64_t value = 0;
+
+			detail::decode_dod_block(_bytes.data() + _offsets[index / _block_size], index % _block_size, 1, &value);
+
+			return value;
+		}
+
+		___nodiscard___ timestamp operator[] (std::size_t index) const
+		{
+			return timestamp(ticks(index));
+		}
+
+		___nodiscard___ date_time get(std::size_t index) const
+		{
+			return date_time::from_ticks(ticks(index));
+		}
+
+		/* Writes the count values from first on to out */
+		void decode(std::size_t first, std::size_t count, std::int64_t* out) const
+		{
+			if ((first > _count) || (count > _count - first))
+				throw basic_error("Index out of range!");
+
+			while (count != 0)
+			{
+				const std::size_t block = first / _block_size;
+				const std::size_t skip = first % _block_size;
+				const std::size_t available = (((block + 1) * _block_size < _count) ? _block_size : (_count - block * _block_size)) - skip;
+				const std::size_t take = (count < available) ? count : available;
+
+				/* The values before first are walked without being stored, so partial blocks need no scratch */
+				detail::decode_dod_block(_bytes.data() + _offsets[block], skip, take, out);
+
+				first += take;
+				count -= take;
+				out += take;
+			}
+		}
+
+		void decode(std::int64_t* out) const
+		{
+			decode(0, _count, out);
+		}
+
+	private:
+		/* Every read may load 8 bytes from any position inside the stream */
+		static ___constexpr___ std::size_t padding = 16;
+
+		/* Up to 56 bits at a time */
+		void _write(std::uint64_t value, unsigned int count)
+		{
+			const std::size_t byte = _bits >> 3;
+
+			if (byte + padding > _bytes.size())
+				_bytes.resize((byte + padding) * 2, 0);
+
+			unsigned char* const out = _bytes.data() + byte;
+
+			detail::store_le64(out, detail::load_le64(out) | (value << (_bits & 7)));
+
+			_bits += count;
+		}
+
+		std::size_t _block_size;
+		std::size_t _count;
+		std::size_t _bits;
+		std::uint64_t _previous;
+		std::uint64_t _delta;
+		std::vector<unsigned char> _bytes;
+		std::vector<std::size_t> _offsets;
+	};
+}
+
+#endif /* TIMESTAMP_CODEC_HPP */
@@ -0,0 +1,461 @@
+#ifndef TIMING_WHEEL_HPP
+#define TIMING_WHEEL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "core_macros.hpp"
+#include "basic_error.hpp"
+#include "date_time.hpp"
+#include "bit_utilities.hpp"
+
+/* The timing_wheel class keeps timers ordered by deadline in a hierarchical timing wheel, so scheduling and cancelling are O(1)
+no matter how many timers are pending. Time is cut into wheel ticks of resolution ticks and a timer never fires before its deadline,
+at most one resolution after it.
+
+There are four levels of 256 slots, level l holding the timers due 256^l to 256^(l + 1) wheel ticks ahead (about 49 days at the default
+1 ms resolution, later deadlines wait in the last level and are placed again when it comes around). Whenever the wheel passes the start
+of a slot of a higher level the timers of that slot move down, so every timer is touched at most once per level. Each level keeps a
+bitmap of its non empty slots, so advancing over a long quiet stretch jumps straight to the next slot with work instead of walking it.
+
+Timers live in a pool of nodes linked by index, pending timers cost no allocation once the pool has grown. A timer_id names a timer
+together with the generation of its node, so cancelling a timer that already fired (or was cancelled) is a harmless no-op.
+
+The payload type has to be default constructible and movable, the default std::function<void()> fires through advance(now). */
+
+namespace dt0
+{
+	template <class T = std::function<void()>>
+	class timing_wheel
+	{
+	public:
+		/* The node index in the low 32 bits and its generation in the high 32 bits, 0 is never a valid timer */
+		using timer_id = std::uint64_t;
+
+		static ___constexpr___ unsigned int levels = 4;
+		static ___constexpr___ unsigned int slots = 256;
+
+		explicit timing_wheel(std::int64_t now, std::int64_t resolution = ticks_per_millisecond) :
+			_origin(now), _now(now), _resolution(resolution), _current(0), _size(0), _free(none), _heads{}, _occupied{}
+		{
+			if (resolution < 1)
+				throw basic_error("Invalid timing wheel resolution!");
+
+			for (std::uint32_t& head : _heads)
+				head = none;
+		}
+
+		explicit timing_wheel(const date_time& now, std::int64_t resolution = ticks_per_millisecond) : timing_wheel(now.ticks(), resolution)
+		{
+
+		}
+
+		explicit timing_wheel(timestamp now, std::int64_t resolution = ticks_per_millisecond) : timing_wheel(now.ticks(), resolution)
+		{
+
+		}
+
+		timing_wheel(const timing_wheel&) = default;
+		timing_wheel(timing_wheel&&) noexcept = default;
+		timing_wheel& operator= (const timing_wheel&) = default;
+		timing_wheel& operator= (timing_wheel&&) noexcept = default;
+
+		~timing_wheel() noexcept = default;
+
+		___nodiscard___ std::size_t size() const noexcept
+		{
+			return _size;
+		}
+
+		___nodiscard___ bool empty() const noexcept
+		{
+			return _size == 0;
+		}
+
+		___nodiscard___ std::int64_t resolution() const noexcept
+		{
+			return _resolution;
+		}
+
+		/* The time of the last advance, relative deadlines count from here */
+		___nodiscard___ std::int64_t now() const noexcept
+		{
+			return _now;
+		}
+
+		/* Grows the node pool up front so scheduling up to count pending timers never allocates */
+		void reserve(std::size_t count)
+		{
+			_nodes.reserve(count);
+		}
+
+		/* Deadlines that already passed fire on the next advance */
+		timer_id schedule(std::int64_t deadline, T payload)
+		{
+			const std::uint32_t index = _allocate();
+			node& n = _nodes[index];
+
+			n.deadline = deadline;
+			n.tick = _tick_of(deadline);
+			n.payload = std::move(payload);
+
+			if (n.tick <= _current)
+				_push(index, due_slot);
+			else
+				_place(index);
+			++_size;
+
+			return (static_cast<timer_id>(n.generation) << 32) | index;
+		}
+
+		timer_id schedule(const date_time& deadline, T payload)
+		{
+			return schedule(deadline.ticks(), std::move(payload));
+		}
+
+		timer_id schedule(timestamp deadline, T payload)
+		{
+			return schedule(deadline.ticks(), std::move(payload));
+		}
+
+		/* Any std::chrono duration (dt0::duration included) after now() */
+		template <class Rep, class Period>
+		timer_id schedule_after(std::chrono::duration<Rep, Period> delay, T payload)
+		{
+			return schedule(_now + to_ticks(delay), std::move(payload));
+		}
+
+		/* False when the timer already fired or was cancelled */
+		bool cancel(timer_id id) noexcept
+		{
+			const std::uint32_t index = static_cast<std::uint32_t>(id);
+
+			if ((index >= _nodes.size()) || (_nodes[index].generation != static_cast<std::uint32_t>(id >> 32)) || (_nodes[index].slot == none_slot))
+				return false;
+
+			_unlink(index);
+			_release(index);
+			--_size;
+
+			return true;
+		}
+
+		___nodiscard___ bool pending(timer_id id) const noexcept
+		{
+			const std::uint32_t index = static_cast<std::uint32_t>(id);
+
+			return (index < _nodes.size()) && (_nodes[index].generation == static_cast<std::uint32_t>(id >> 32)) && (_nodes[index].slot != none_slot);
+		}
+
+		/* The deadline the timer was scheduled with, the timer has to be pending */
+		___nodiscard___ std::int64_t deadline(timer_id id) const
+		{
+			if (!pending(id))
+				throw basic_error("Timer is not pending!");
+
+			return _nodes[static_cast<std::uint32_t>(id)].deadline;
+		}
+
+		/* Moves the wheel to now and hands the payload of every timer that came due to on_expired, returns how many fired.
+		on_expired takes a T& and may schedule and cancel timers, timers it schedules at or before now fire in the same call. */
+		template <class F>
+		std::size_t advance(std::int64_t now, F&& on_expired)
+		{
+			std::size_t fired = 0;
+
+			if (now > _now)
+				_now = now;
+
+			const std::int64_t target = _tick_floor(_now);
+
+			for (;;)
+			{
+				fired += _fire(due_slot, on_expired);
+
+				if (_current >= target)
+					break;
+
+				const std::int64_t next = _next_event();
+
+				if (next > target)
+				{
+					_current = target;
+					continue;
+				}
+
+				_current = next;
+
+				for (unsigned int level = levels - 1; level != 0; --level)
+				{
+					if ((next & ((static_cast<std::int64_t>(1) << (8 * level)) - 1)) == 0)
+						_cascade(level * slots + static_cast<unsigned int>((next >> (8 * level)) & (slots - 1)));
+				}
+
+				fired += _fire(static_cast<unsigned int>(next & (slots - 1)), on_expired);
+			}
+
+			return fired;
+		}
+
+		template <class F>
+		std::size_t advance(const date_time& now, F&& on_expired)
+		{
+			return advance(now.ticks(), std::forward<F>(on_expired));
+		}
+
+		template <class F>
+		std::size_t advance(timestamp now, F&& on_expired)
+		{
+			return advance(now.ticks(), std::forward<F>(on_expired));
+		}
+
+		/* Calls the payload of every timer that came due */
+		std::size_t advance(std::int64_t now)
+		{
+			return advance(now, [](T& payload) { payload(); });
+		}
+
+		std::size_t advance(const date_time& now)
+		{
+			return advance(now.ticks());
+		}
+
+		std::size_t advance(timestamp now)
+		{
+			return advance(now.ticks());
+		}
+
+		/* Appends the payloads of the timers that came due to expired, in batches instead of callbacks */
+		std::size_t expire(std::int64_t now, std::vector<T>& expired)
+		{
+			return advance(now, [&expired](T& payload) { expired.push_back(std::move(payload)); });
+		}
+
+		std::size_t expire(const date_time& now, std::vector<T>& expired)
+		{
+			return expire(now.ticks(), expired);
+		}
+
+		std::size_t expire(timestamp now, std::vector<T>& expired)
+		{
+			return expire(now.ticks(), expired);
+		}
+
+	private:
+		static ___constexpr___ std::uint32_t none = 0xFFFFFFFFu;
+		static ___constexpr___ std::uint16_t none_slot = 0xFFFF;
+
+		/* Timers scheduled for a wheel tick that already passed wait here for the next advance */
+		static ___constexpr___ unsigned int due_slot = levels * slots;
+
+		struct node
+		{
+			std::int64_t deadline;
+			std::int64_t tick;
+			std::uint32_t previous;
+			std::uint32_t next;
+			std::uint32_t generation;
+			std::uint16_t slot;
+			T payload;
+		};
+
+		/* Deadlines round up to whole wheel ticks, so nothing fires early */
+		___nodiscard___ std::int64_t _tick_of(std::int64_t deadline) const noexcept
+		{
+			const std::int64_t offset = deadline - _origin;
+
+			return (offset <= 0) ? 0 : (offset / _resolution + ((offset % _resolution) != 0 ? 1 : 0));
+		}
+
+		___nodiscard___ std::int64_t _tick_floor(std::int64_t now) const noexcept
+		{
+			return (now <= _origin) ? 0 : ((now - _origin) / _resolution);
+		}
+
+		std::uint32_t _allocate()
+		{
+			if (_free != none)
+			{
+				const std::uint32_t index = _free;
+
+				_free = _nodes[index].next;
+
+				/* Generation 0 is skipped so no timer_id is ever 0 */
+				if (++_nodes[index].generation == 0)
+					_nodes[index].generation = 1;
+
+				return index;
+			}
+
+			if (_nodes.size() == none)
+				throw basic_error("Too many timers!");
+
+			_nodes.push_back(node{ 0, 0, none, none, 1, none_slot, T() });
+
+			return static_cast<std::uint32_t>(_nodes.size() - 1);
+		}
+
+		void _release(std::uint32_t index) noexcept
+		{
+			node& n = _nodes[index];
+
+			n.payload = T();
+			n.slot = none_slot;
+			n.next = _free;
+
+			_free = index;
+		}
+
+		/* Level l takes the timers less than 256^(l + 1) wheel ticks ahead, the slot is the level's digit of the due tick */
+		void _place(std::uint32_t index) noexcept
+		{
+			node& n = _nodes[index];
+
+			const std::int64_t delta = n.tick - _current;
+			unsigned int level = 0;
+
+			while ((level + 1 < levels) && (delta >= (static_cast<std::int64_t>(1) << (8 * (level + 1)))))
+				++level;
+
+			unsigned int slot;
+
+			if (delta >= (static_cast<std::int64_t>(1) << (8 * levels)))
+				slot = static_cast<unsigned int>(((_current >> (8 * level)) + slots - 1) & (slots - 1));
+			else
+				slot = static_cast<unsigned int>((n.tick >> (8 * level)) & (slots - 1));
+
+			_push(index, level * slots + slot);
+			_occupied[(level * slots + slot) / 64] |= static_cast<std::uint64_t>(1) << (slot % 64);
+		}
+
+		void _push(std::uint32_t index, unsigned int slot) noexcept
+		{
+			node& n = _nodes[index];
+
+			n.slot = static_cast<std::uint16_t>(slot);
+			n.previous = none;
+			n.next = _heads[slot];
+
+			if (n.next != none)
+				_nodes[n.next].previous = index;
+
+			_heads[slot] = index;
+		}
+
+		/* Hands out the slot's timers one at a time, so on_expired may cancel any of them or schedule new ones */
+		template <class F>
+		std::size_t _fire(unsigned int slot, F& on_expired)
+		{
+			std::size_t fired = 0;
+
+			while (_heads[slot] != none)
+			{
+				const std::uint32_t index = _heads[slot];
+
+				_unlink(index);
+
+				T payload = std::move(_nodes[index].payload);
+
+				_release(index);
+				--_size;
+				++fired;
+
+				on_expired(payload);
+			}
+
+			return fired;
+		}
+
+		void _unlink(std::uint32_t index) noexcept
+		{
+			node& n = _nodes[index];
+
+			if (n.previous != none)
+				_nodes[n.previous].next = n.next;
+			else
+				_heads[n.slot] = n.next;
+
+			if (n.next != none)
+				_nodes[n.next].previous = n.previous;
+
+			if ((_heads[n.slot] == none) && (n.slot != due_slot))
+				_occupied[n.slot / 64] &= ~(static_cast<std::uint64_t>(1) << (n.slot % 64));
+		}
+
+		/* Moves the timers of a higher level slot down now that the wheel reached it */
+		void _cascade(unsigned int slot) noexcept
+		{
+			std::uint32_t index = _heads[slot];
+
+			_heads[slot] = none;
+			_occupied[slot / 64] &= ~(static_cast<std::uint64_t>(1) << (slot % 64));
+
+			while (index != none)
+			{
+				const std::uint32_t next = _nodes[index].next;
+
+				_place(index);
+				index = next;
+			}
+		}
+
+		/* Distance from slot first to the next non empty slot of a level going round, or slots when the level is empty */
+		___nodiscard___ unsigned int _distance(unsigned int level, unsigned int first) const noexcept
+		{
+			const std::uint64_t* const words = _occupied + level * (slots / 64);
+
+			for (unsigned int step = 0; step < slots; step += 64)
+			{
+				const unsigned int position = (first + step) & (slots - 1);
+				const unsigned int shift = position % 64;
+
+				std::uint64_t bits = words[position / 64] >> shift;
+
+				if (shift != 0)
+					bits |= words[((position / 64) + 1) % (slots / 64)] << (64 - shift);
+
+				if (bits != 0)
+					return step + detail::count_trailing_zeros(bits);
+			}
+
+			return slots;
+		}
+
+		/* The first wheel tick after the current one that fires a level 0 slot or starts a non empty higher level slot */
+		___nodiscard___ std::int64_t _next_event() const noexcept
+		{
+			std::int64_t next = INT64_MAX;
+
+			for (unsigned int level = 0; level < levels; ++level)
+			{
+				const std::int64_t block = (_current >> (8 * level)) + 1;
+				const unsigned int distance = _distance(level, static_cast<unsigned int>(block & (slots - 1)));
+
+				if (distance != slots)
+				{
+					const std::int64_t tick = (block + distance) << (8 * level);
+
+					if (tick < next)
+						next = tick;
+				}
+			}
+
+			return next;
+		}
+
+		std::int64_t _origin;
+		std::int64_t _now;
+		std::int64_t _resolution;
+		std::int64_t _current;
+		std::size_t _size;
+		std::uint32_t _free;
+		std::uint32_t _heads[levels * slots + 1];
+		std::uint64_t _occupied[levels * slots / 64];
+		std::vector<node> _nodes;
+	};
+}
+
+#endif /* TIMING_WHEEL_HPP */